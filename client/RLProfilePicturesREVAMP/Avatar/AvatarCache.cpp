@@ -0,0 +1,158 @@
+#include "pch.h"
+#include "AvatarCache.h"
+#include "ByteBufferPool.h"
+#include "../Config/Constants.h"
+#include "../Utils/Logger.h"
+#include "../Utils/FileUtils.h"
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+// =============================================================================
+// AVATAR CACHE
+// =============================================================================
+
+uint64_t AvatarCache::HashId(const FUniqueNetId& id) {
+    // FNV-1a over platform + uid + epic account id string
+    constexpr uint64_t kOffset = 14695981039346656037ull;
+    constexpr uint64_t kPrime = 1099511628211ull;
+
+    uint64_t hash = kOffset;
+    auto mix = [&hash](const uint8_t* bytes, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= kPrime;
+        }
+    };
+
+    uint8_t platform = id.Platform;
+    mix(&platform, sizeof(platform));
+    mix(reinterpret_cast<const uint8_t*>(&id.Uid), sizeof(id.Uid));
+
+    // Mix the Epic account ID straight from the FString buffer (ASCII hex
+    // characters); converting through ToString() allocated on every hash,
+    // for every platform, Epic or not
+    const FString& epicId = id.EpicAccountId;
+    if (!epicId.empty() && epicId.isValid()) {
+        for (const wchar_t* p = epicId.c_str(); *p; ++p) {
+            hash ^= static_cast<uint8_t>(*p);
+            hash *= kPrime;
+        }
+    }
+
+    return hash;
+}
+
+std::shared_ptr<const std::vector<uint8_t>> AvatarCache::Get(uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return nullptr;
+    }
+
+    // Move to front (most recently used)
+    lru.splice(lru.begin(), lru, it->second);
+    return it->second->data;
+}
+
+void AvatarCache::Put(uint64_t key, std::shared_ptr<const std::vector<uint8_t>> data) {
+    if (!data || data->empty()) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        totalBytes -= it->second->data->size();
+        lru.erase(it->second);
+        index.erase(it);
+    }
+
+    totalBytes += data->size();
+    lru.push_front(Entry{ key, std::move(data) });
+    index[key] = lru.begin();
+
+    // Evict least-recently-used entries until within budget
+    while (totalBytes > RLProfilePicturesConstants::AVATAR_CACHE_MAX_BYTES && !lru.empty()) {
+        Entry& victim = lru.back();
+        totalBytes -= victim.data->size();
+        index.erase(victim.key);
+        lru.pop_back();
+    }
+}
+
+void AvatarCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    index.clear();
+    totalBytes = 0;
+}
+
+namespace {
+    // On-disk location for a cache key, e.g. <temp>/rlpp_avatar_cache/0123456789abcdef.png
+    std::filesystem::path DiskPathForKey(uint64_t key) {
+        return RLProfilePicturesFileUtils::GetTempDirectory() /
+               RLProfilePicturesConstants::TEMP_CACHE_DIRECTORY /
+               std::format("{:016x}.png", key);
+    }
+}
+
+std::shared_ptr<const std::vector<uint8_t>> AvatarCache::LoadFromDisk(uint64_t key) {
+    try {
+        std::filesystem::path path = DiskPathForKey(key);
+
+        std::error_code ec;
+        auto writeTime = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            return nullptr; // no persisted entry
+        }
+
+        auto age = std::filesystem::file_time_type::clock::now() - writeTime;
+        if (age > std::chrono::seconds(RLProfilePicturesConstants::AVATAR_DISK_CACHE_TTL)) {
+            std::filesystem::remove(path, ec);
+            return nullptr;
+        }
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.good()) {
+            return nullptr;
+        }
+
+        auto size = static_cast<size_t>(file.tellg());
+        if (size == 0) {
+            return nullptr;
+        }
+        file.seekg(0);
+
+        auto buffer = ByteBufferPool::Instance().Acquire();
+        buffer->resize(size);
+        if (!file.read(reinterpret_cast<char*>(buffer->data()), size)) {
+            return nullptr;
+        }
+        return buffer;
+    }
+    catch (const std::exception& e) {
+        RLPP_LOG_DEBUG("Disk cache read failed: " + std::string(e.what()));
+        return nullptr;
+    }
+}
+
+void AvatarCache::StoreToDisk(uint64_t key, const std::vector<uint8_t>& data) {
+    if (data.empty()) return;
+
+    try {
+        std::filesystem::path path = DiskPathForKey(key);
+        std::filesystem::create_directories(path.parent_path());
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.good()) {
+            RLPP_LOG_DEBUG("Disk cache write failed for key " + std::format("{:016x}", key));
+            return;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+    catch (const std::exception& e) {
+        RLPP_LOG_DEBUG("Disk cache write failed: " + std::string(e.what()));
+    }
+}
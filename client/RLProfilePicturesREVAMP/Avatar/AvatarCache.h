@@ -0,0 +1,82 @@
+#pragma once
+
+#include "RLSDK/SdkHeaders.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// =============================================================================
+// AVATAR CACHE
+// =============================================================================
+
+/**
+ * Bounded in-memory LRU cache of downloaded avatar bytes.
+ *
+ * Re-seeing the same player (scoreboard redraws, rejoining a lobby) used to
+ * re-download their PNG every time. Caching the raw bytes short-circuits the
+ * whole HTTP path on a hit. Entries are evicted least-recently-used once the
+ * byte budget is exceeded.
+ */
+class AvatarCache {
+public:
+    /**
+     * Hashes a unique network ID into a cache key
+     * Combines platform, numeric UID and the Epic account ID string
+     * @param id The unique network ID
+     * @return 64-bit cache key
+     */
+    static uint64_t HashId(const FUniqueNetId& id);
+
+    /**
+     * Looks up cached avatar bytes and marks the entry most-recently-used
+     * The returned pointer shares ownership with the cache, so hits cost a
+     * refcount bump instead of a byte copy
+     * @param key Cache key from HashId
+     * @return The cached bytes, or nullptr on miss
+     */
+    std::shared_ptr<const std::vector<uint8_t>> Get(uint64_t key);
+
+    /**
+     * Inserts (or refreshes) avatar bytes for a key, evicting LRU entries
+     * as needed to stay within the byte budget
+     * @param key Cache key from HashId
+     * @param data The avatar bytes to cache
+     */
+    void Put(uint64_t key, std::shared_ptr<const std::vector<uint8_t>> data);
+
+    /**
+     * Removes all cached entries
+     */
+    void Clear();
+
+    /**
+     * Loads avatar bytes persisted by a previous session, so relaunching the
+     * game does not re-download every player. Entries older than
+     * AVATAR_DISK_CACHE_TTL are deleted and treated as misses
+     * @param key Cache key from HashId
+     * @return The persisted bytes, or nullptr on miss/expiry
+     */
+    static std::shared_ptr<const std::vector<uint8_t>> LoadFromDisk(uint64_t key);
+
+    /**
+     * Persists avatar bytes for reuse across sessions
+     * Failures are logged and otherwise ignored; the disk tier is best-effort
+     * @param key Cache key from HashId
+     * @param data The avatar bytes to persist
+     */
+    static void StoreToDisk(uint64_t key, const std::vector<uint8_t>& data);
+
+private:
+    struct Entry {
+        uint64_t key;
+        std::shared_ptr<const std::vector<uint8_t>> data;
+    };
+
+    std::list<Entry> lru; // front = most recently used
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+    std::mutex mutex;
+    size_t totalBytes = 0;
+};
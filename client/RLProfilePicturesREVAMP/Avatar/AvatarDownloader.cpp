@@ -1,173 +1,545 @@
 #include "pch.h"
 #include "AvatarDownloader.h"
+#include "AvatarHttpClient.h"
+#include "AvatarManager.h"
 #include "../Config/Constants.h"
 #include "../Utils/Logger.h"
 #include "../Utils/FileUtils.h"
 #include "../RocketLeague/RLObjects.h"
+#include <array>
 #include <format>
-
-// Forward declaration for AvatarManager
-class AvatarManager;
+#include <string_view>
 
 // =============================================================================
 // AVATAR DOWNLOADER
 // =============================================================================
 
-AvatarDownloader::AvatarDownloader(std::shared_ptr<GameWrapper> gw, 
-                                   std::function<void(FUniqueNetId, const std::vector<uint8_t>&)> callback) 
-    : gameWrapper(gw), loadAvatarCallback(callback) {}
+AvatarDownloader::AvatarDownloader(std::shared_ptr<GameWrapper> gw, AvatarManager* manager)
+    : gameWrapper(gw), manager(manager) {
+    BindCvar(RLProfilePicturesConstants::CVAR_LOAD_DEFAULT_AVATARS, cvLoadDefaults);
+    BindCvar(RLProfilePicturesConstants::CVAR_STEAM_ENABLED, cvSteamEnabled);
+    BindCvar(RLProfilePicturesConstants::CVAR_EPIC_ENABLED, cvEpicEnabled);
+    BindCvar(RLProfilePicturesConstants::CVAR_XBOX_ENABLED, cvXboxEnabled);
+    BindCvar(RLProfilePicturesConstants::CVAR_PSN_ENABLED, cvPsnEnabled);
+    BindCvar(RLProfilePicturesConstants::CVAR_SWITCH_ENABLED, cvSwitchEnabled);
+}
+
+void AvatarDownloader::BindCvar(const char* name, std::atomic<bool>& target) {
+    extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
+    if (!_globalCvarManager) return;
+
+    CVarWrapper cv = _globalCvarManager->getCvar(name);
+    if (cv.IsNull()) return;
+
+    target.store(cv.getBoolValue(), std::memory_order_relaxed);
+    cv.addOnValueChanged([&target](std::string, CVarWrapper cvar) {
+        target.store(cvar.getBoolValue(), std::memory_order_relaxed);
+    });
+}
+
+bool AvatarDownloader::IsLocalOnSteam() {
+    int cached = localOnSteamCached.load(std::memory_order_relaxed);
+    if (cached >= 0) {
+        return cached != 0;
+    }
+
+    if (auto* localId = RL::GetPrimaryPlayerID()) {
+        bool onSteam = (static_cast<EOnlinePlatform>(localId->Platform) == EOnlinePlatform::OnlinePlatform_Steam);
+        localOnSteamCached.store(onSteam ? 1 : 0, std::memory_order_relaxed);
+        return onSteam;
+    }
+    // Local ID not available yet; don't cache the miss
+    return false;
+}
+
+namespace {
+    // Concatenates API_BASE_URL + endpoint once at startup, so per-call URL
+    // construction never re-joins the constant parts
+    std::string ApiPrefix(const char* endpoint) {
+        return std::string(RLProfilePicturesConstants::API_BASE_URL) + endpoint;
+    }
+}
+
+// One row per EOnlinePlatform ordinal (see Core_classes.hpp). Xbox carries a
+// prefix but no Uid/Epic form: it goes through DownloadXboxAvatar with names.
+const std::array<AvatarDownloader::PlatformDesc, 12> AvatarDownloader::kPlatforms = { {
+    /* Unknown  */ {},
+    /* Steam    */ { ApiPrefix(RLProfilePicturesConstants::API_STEAM_RETRIEVE),  &AvatarDownloader::cvSteamEnabled,  PlatformDesc::IdForm::Uid },
+    /* PS4      */ { ApiPrefix(RLProfilePicturesConstants::API_PSN_RETRIEVE),    &AvatarDownloader::cvPsnEnabled,    PlatformDesc::IdForm::Uid },
+    /* PS3      */ {},
+    /* Dingo    */ { ApiPrefix(RLProfilePicturesConstants::API_XBOX_RETRIEVE),   &AvatarDownloader::cvXboxEnabled,   PlatformDesc::IdForm::XboxName },
+    /* QQ       */ {},
+    /* OldNNX   */ {},
+    /* NNX      */ { ApiPrefix(RLProfilePicturesConstants::API_SWITCH_RETRIEVE), &AvatarDownloader::cvSwitchEnabled, PlatformDesc::IdForm::Uid },
+    /* PsyNet   */ {},
+    /* Deleted  */ {},
+    /* WeGame   */ {},
+    /* Epic     */ { ApiPrefix(RLProfilePicturesConstants::API_EPIC_RETRIEVE),   &AvatarDownloader::cvEpicEnabled,   PlatformDesc::IdForm::Epic },
+} };
 
 std::string AvatarDownloader::GetURLForID(FUniqueNetId id) {
     if (!IsAllowed(id))
         return "";
-    
-    std::string baseUrl = RLProfilePicturesConstants::API_BASE_URL;
-	// Know if the default avatar should be returned if none is set
-	// Get from CVar, default to true if CVarManager not available
-	bool default_value = _globalCvarManager->getCvar(RLProfilePicturesConstants::CVAR_LOAD_DEFAULT_AVATARS).getBoolValue();
-	std::string default_enabled = default_value ? "true" : "false";
-    switch (static_cast<EOnlinePlatform>(id.Platform)) {
-    case EOnlinePlatform::OnlinePlatform_Steam:
-        return baseUrl + RLProfilePicturesConstants::API_STEAM_RETRIEVE + std::to_string(id.Uid) + "?default_enabled=" + default_enabled;
-    case EOnlinePlatform::OnlinePlatform_Epic:
-        return baseUrl + RLProfilePicturesConstants::API_EPIC_RETRIEVE + id.EpicAccountId.ToString() + "?default_enabled=" + default_enabled;
-    case EOnlinePlatform::OnlinePlatform_Dingo: // Xbox
-        return ""; // Xbox uses DownloadXboxAvatar with player names
-    case EOnlinePlatform::OnlinePlatform_PS4:
-        return baseUrl + RLProfilePicturesConstants::API_PSN_RETRIEVE + std::to_string(id.Uid) + "?default_enabled=" + default_enabled;
-    case EOnlinePlatform::OnlinePlatform_NNX: // Switch
-        return baseUrl + RLProfilePicturesConstants::API_SWITCH_RETRIEVE + std::to_string(id.Uid) + "?default_enabled=" + default_enabled;
-    }
-    return "";
+
+    const PlatformDesc& desc = kPlatforms[id.Platform]; // bounds-checked by IsAllowed
+    if (desc.form != PlatformDesc::IdForm::Uid && desc.form != PlatformDesc::IdForm::Epic)
+        return ""; // Xbox and unsupported platforms have no ID-based URL
+
+    // Single formatted write instead of a chain of string concatenations
+    return std::format("{}{}?default_enabled={}",
+                       desc.prefix,
+                       desc.form == PlatformDesc::IdForm::Epic ? id.EpicAccountId.ToString() : std::to_string(id.Uid),
+                       cvLoadDefaults.load(std::memory_order_relaxed) ? "true" : "false");
 }
 
 bool AvatarDownloader::IsAllowed(FUniqueNetId id) {
-    // Check if local player is on Steam (affects Steam avatar policy)
-    bool localOnSteam = false;
-    if (auto* localId = RL::GetPrimaryPlayerID()) {
-        localOnSteam = (static_cast<EOnlinePlatform>(localId->Platform) == EOnlinePlatform::OnlinePlatform_Steam);
-    }
-    
-    // Helper lambda to get CVar values safely
-    auto getCVarBool = [](const char* name) -> bool {
-        extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
-        if (!_globalCvarManager) return false;
-        CVarWrapper cv = _globalCvarManager->getCvar(name);
-        return !cv.IsNull() && cv.getBoolValue();
-    };
-    
-    switch (static_cast<EOnlinePlatform>(id.Platform)) {
-    case EOnlinePlatform::OnlinePlatform_Steam:
-        // Only allow Steam avatars if local player is NOT on Steam (game handles local Steam avatars)
-        return !localOnSteam && getCVarBool(RLProfilePicturesConstants::CVAR_STEAM_ENABLED);
-        
-    case EOnlinePlatform::OnlinePlatform_Epic:
-        return getCVarBool(RLProfilePicturesConstants::CVAR_EPIC_ENABLED);
-        
-    case EOnlinePlatform::OnlinePlatform_Dingo: // Xbox
-        return getCVarBool(RLProfilePicturesConstants::CVAR_XBOX_ENABLED);
-        
-    case EOnlinePlatform::OnlinePlatform_PS4:
-        return getCVarBool(RLProfilePicturesConstants::CVAR_PSN_ENABLED);
-        
-    case EOnlinePlatform::OnlinePlatform_NNX: // Switch
-        return getCVarBool(RLProfilePicturesConstants::CVAR_SWITCH_ENABLED);
-        
-    default:
+    size_t platform = id.Platform;
+    if (platform >= kPlatforms.size())
+        return false;
+
+    const PlatformDesc& desc = kPlatforms[platform];
+    if (!desc.enabled || !(this->*desc.enabled).load(std::memory_order_relaxed))
+        return false;
+
+    // Only allow Steam avatars if local player is NOT on Steam (game handles local Steam avatars)
+    if (static_cast<EOnlinePlatform>(id.Platform) == EOnlinePlatform::OnlinePlatform_Steam && IsLocalOnSteam())
+        return false;
+
+    return true;
+}
+
+bool AvatarDownloader::IsNegativeCached(uint64_t key) {
+    std::lock_guard<std::mutex> lock(negativeMutex);
+    auto it = negativeCache.find(key);
+    if (it == negativeCache.end()) {
+        return false;
+    }
+    auto age = std::chrono::steady_clock::now() - it->second;
+    if (age > std::chrono::seconds(RLProfilePicturesConstants::AVATAR_NEGATIVE_CACHE_TTL)) {
+        negativeCache.erase(it);
+        return false;
+    }
+    return true;
+}
+
+void AvatarDownloader::MarkNegative(uint64_t key) {
+    std::lock_guard<std::mutex> lock(negativeMutex);
+    negativeCache[key] = std::chrono::steady_clock::now();
+}
+
+bool AvatarDownloader::TryServeFromDisk(FUniqueNetId id, uint64_t cacheKey) {
+    auto data = AvatarCache::LoadFromDisk(cacheKey);
+    if (!data) {
         return false;
     }
+
+    // Promote so later lookups hit the in-memory tier directly
+    byteCache.Put(cacheKey, data);
+
+    gameWrapper->Execute([this, id, data = std::move(data)](GameWrapper* gw) {
+        manager->LoadAvatar(id, data);
+    });
+    return true;
+}
+
+bool AvatarDownloader::TryBeginRequest(uint64_t key) {
+    std::lock_guard<std::mutex> lock(inflightMutex);
+    return inflight.insert(key).second;
+}
+
+void AvatarDownloader::EndRequest(uint64_t key) {
+    std::lock_guard<std::mutex> lock(inflightMutex);
+    inflight.erase(key);
 }
 
 void AvatarDownloader::DownloadAvatar(FUniqueNetId id) {
-    std::string idString = UOnline_X::UniqueNetIdToString(id).ToString();
+    // The ID string only feeds debug logging; skip the SDK FString
+    // conversion entirely when debug logs are off
+    const bool debugLogs = RLProfilePicturesLogger::IsDebugEnabled();
+    auto idStr = [&id] { return UOnline_X::UniqueNetIdToString(id).ToString(); };
+
     std::string url = GetURLForID(id);
-    
-    RLProfilePicturesLogger::LogDebug("DownloadAvatar called for ID: " + idString);
-    
+
+    if (debugLogs) RLProfilePicturesLogger::LogDebug("DownloadAvatar called for ID: " + idStr());
+
     if (url.empty()) {
-        RLProfilePicturesLogger::LogDebug("Empty URL for ID: " + idString);
+        if (debugLogs) RLProfilePicturesLogger::LogDebug("Empty URL for ID: " + idStr());
         return;
     }
-    
-    // TODO: Check avatar cache here (will be implemented in AvatarManager) 
-    // a fucking TODO that existed from before dinosaurs existed, now i dont even know what it meant
-    
-    CurlRequest req;
-    req.url = url;
-    req.verb = "GET";
-    
-    HttpWrapper::SendCurlRequest(req, [this, id, idString](int http_code, char* data_ptr, size_t data_size) {
-        RLProfilePicturesLogger::LogDebug("HTTP response for ID " + idString + ": code=" + 
-                                         std::to_string(http_code) + ", size=" + std::to_string(data_size));
-        
+
+    // Serve from the byte cache when we've already downloaded this player
+    uint64_t cacheKey = AvatarCache::HashId(id);
+    if (auto cached = byteCache.Get(cacheKey)) {
+        if (debugLogs) RLProfilePicturesLogger::LogDebug("Avatar byte-cache hit for ID: " + idStr());
+        gameWrapper->Execute([this, id, cached = std::move(cached)](GameWrapper* gw) {
+            manager->LoadAvatar(id, cached);
+        });
+        return;
+    }
+
+    if (IsNegativeCached(cacheKey)) {
+        if (debugLogs) RLProfilePicturesLogger::LogDebug("Negative-cache hit for ID: " + idStr() + ", skipping request");
+        return;
+    }
+
+    if (TryServeFromDisk(id, cacheKey)) {
+        if (debugLogs) RLProfilePicturesLogger::LogDebug("Avatar disk-cache hit for ID: " + idStr());
+        return;
+    }
+
+    if (!TryBeginRequest(cacheKey)) {
+        if (debugLogs) RLProfilePicturesLogger::LogDebug("Request already in flight for ID: " + idStr() + ", skipping duplicate");
+        return;
+    }
+
+    // Capture the small POD id, not the string; reconstruct only when logging
+    AvatarHttpClient::Instance().SendGet(url, [this, id, cacheKey](int http_code, char* data_ptr, size_t data_size) {
+        EndRequest(cacheKey);
+        const bool debugLogs = RLProfilePicturesLogger::IsDebugEnabled();
+        auto idStr = [&id] { return UOnline_X::UniqueNetIdToString(id).ToString(); };
+        if (debugLogs) {
+            RLPP_LOG_DEBUG("HTTP response for ID " + idStr() + ": code=" +
+                                             std::to_string(http_code) + ", size=" + std::to_string(data_size));
+        }
+
         if (http_code != 200) {
-            RLProfilePicturesLogger::LogDebug("HTTP request failed for ID " + idString + 
-                                             " with code: " + std::to_string(http_code));
+            if (debugLogs) {
+                RLPP_LOG_DEBUG("HTTP request failed for ID " + idStr() +
+                                                 " with code: " + std::to_string(http_code));
+            }
+            MarkNegative(cacheKey);
             return;
         }
-        
+
         if (data_ptr == nullptr || data_size == 0) {
-            RLProfilePicturesLogger::LogDebug("No data received for ID: " + idString);
-            
+            if (debugLogs) RLProfilePicturesLogger::LogDebug("No data received for ID: " + idStr());
+            MarkNegative(cacheKey);
             return;
         }
-        
-        std::vector<uint8_t> data(data_ptr, data_ptr + data_size);
-        
+
+        auto buffer = ByteBufferPool::Instance().Acquire();
+        buffer->assign(data_ptr, data_ptr + data_size);
+        std::shared_ptr<const std::vector<uint8_t>> data = buffer;
+        byteCache.Put(cacheKey, data);
+        AvatarCache::StoreToDisk(cacheKey, *data); // still on the HTTP thread
+
         // Use gameWrapper->Execute to ensure we're on the game thread
-        gameWrapper->Execute([this, id, data](GameWrapper* gw) {
-            RLProfilePicturesLogger::LogSuccess("Avatar downloaded for ID: " + 
+        gameWrapper->Execute([this, id, data = std::move(data)](GameWrapper* gw) {
+            RLProfilePicturesLogger::LogSuccess("Avatar downloaded for ID: " +
                                                UOnline_X::UniqueNetIdToString(id).ToString());
-            if (loadAvatarCallback) {
-                loadAvatarCallback(id, data);
-            }
+            manager->LoadAvatar(id, data);
         });
     });
 }
 
-void AvatarDownloader::DownloadXboxAvatar(FUniqueNetId id, std::string playername) {
-    bool default_value = _globalCvarManager->getCvar(RLProfilePicturesConstants::CVAR_LOAD_DEFAULT_AVATARS).getBoolValue();
-    std::string default_enabled = default_value ? "true" : "false";
-    std::string url = std::string(RLProfilePicturesConstants::API_BASE_URL) + 
-                     RLProfilePicturesConstants::API_XBOX_RETRIEVE + playername + "?default_enabled=" + default_enabled;
-    std::string idString = UOnline_X::UniqueNetIdToString(id).ToString();
-    
-    // TODO: Check avatar cache here (will be implemented in AvatarManager)
-    
-    CurlRequest req;
-    req.url = url;
-    req.verb = "GET";
-    
-    HttpWrapper::SendCurlRequest(req, [this, id, idString](int http_code, char* data_ptr, size_t data_size) {
-        RLProfilePicturesLogger::LogDebug("HTTP response for ID " + idString + ": code=" + 
-                                         std::to_string(http_code) + ", size=" + std::to_string(data_size));
-        
+namespace {
+    // Decodes standard base64 (as produced by the bulk endpoint's avatar_data field)
+    std::vector<uint8_t> DecodeBase64(const std::string& encoded) {
+        // Reverse table built at compile time, like the CRC and gamma
+        // tables: this runs concurrently on HTTP completion threads, so
+        // there is no first-call race to guard against
+        static constexpr auto kReverse = [] {
+            constexpr std::string_view alphabet =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            std::array<int8_t, 256> t{};
+            for (int i = 0; i < 256; i++) t[i] = -1;
+            for (int i = 0; i < 64; i++) t[static_cast<uint8_t>(alphabet[i])] = static_cast<int8_t>(i);
+            return t;
+        }();
+
+        std::vector<uint8_t> decoded;
+        decoded.reserve((encoded.size() / 4) * 3);
+        int value = 0;
+        int bits = 0;
+        for (char c : encoded) {
+            if (c == '=') break;
+            int8_t digit = kReverse[static_cast<uint8_t>(c)];
+            if (digit < 0) continue; // skip whitespace/padding noise
+            value = (value << 6) | digit;
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                decoded.push_back(static_cast<uint8_t>((value >> bits) & 0xFF));
+            }
+        }
+        return decoded;
+    }
+
+    // Extracts the string value of "key":"value" starting the search at pos
+    // within the bounds [pos, end). Returns empty string if not present.
+    std::string ExtractJsonString(const std::string& json, const std::string& key, size_t pos, size_t end) {
+        std::string needle = "\"" + key + "\":";
+        size_t keyPos = json.find(needle, pos);
+        if (keyPos == std::string::npos || keyPos >= end) return "";
+        size_t valueStart = json.find('"', keyPos + needle.size());
+        if (valueStart == std::string::npos || valueStart >= end) return "";
+        size_t valueEnd = json.find('"', valueStart + 1);
+        if (valueEnd == std::string::npos || valueEnd > end) return "";
+        return json.substr(valueStart + 1, valueEnd - valueStart - 1);
+    }
+
+    // Reads the boolean value of "key": true/false with a single scan.
+    // Strict about the literal that follows the key, so "success":false
+    // next to some other "true" in the body no longer counts as success.
+    bool ExtractJsonBool(const std::string& json, const std::string& key) {
+        std::string needle = "\"" + key + "\"";
+        size_t keyPos = json.find(needle);
+        if (keyPos == std::string::npos) return false;
+
+        size_t pos = keyPos + needle.size();
+        while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' ||
+                                     json[pos] == '\r' || json[pos] == '\n')) pos++;
+        if (pos >= json.size() || json[pos] != ':') return false;
+        pos++;
+        while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' ||
+                                     json[pos] == '\r' || json[pos] == '\n')) pos++;
+
+        return json.compare(pos, 4, "true") == 0;
+    }
+}
+
+const char* AvatarDownloader::PlatformSlug(EOnlinePlatform platform) {
+    switch (platform) {
+    case EOnlinePlatform::OnlinePlatform_Steam: return "steam";
+    case EOnlinePlatform::OnlinePlatform_Epic:  return "epic";
+    case EOnlinePlatform::OnlinePlatform_PS4:   return "psn";
+    case EOnlinePlatform::OnlinePlatform_NNX:   return "switch";
+    default: return nullptr; // Xbox goes through DownloadXboxAvatar with player names
+    }
+}
+
+std::string AvatarDownloader::IdStringForBatch(const FUniqueNetId& id) {
+    if (static_cast<EOnlinePlatform>(id.Platform) == EOnlinePlatform::OnlinePlatform_Epic) {
+        return id.EpicAccountId.ToString();
+    }
+    return std::to_string(id.Uid);
+}
+
+void AvatarDownloader::EnqueueAvatar(FUniqueNetId id) {
+    if (!IsAllowed(id))
+        return;
+
+    if (!PlatformSlug(static_cast<EOnlinePlatform>(id.Platform))) {
+        // Platform has no bulk endpoint, use the single-ID path
+        DownloadAvatar(id);
+        return;
+    }
+
+    if (IsNegativeCached(AvatarCache::HashId(id))) {
+        return;
+    }
+
+    // Cached players never need to enter the batch
+    if (auto cached = byteCache.Get(AvatarCache::HashId(id))) {
+        gameWrapper->Execute([this, id, cached = std::move(cached)](GameWrapper* gw) {
+            manager->LoadAvatar(id, cached);
+        });
+        return;
+    }
+
+    if (TryServeFromDisk(id, AvatarCache::HashId(id))) {
+        return;
+    }
+
+    if (!TryBeginRequest(AvatarCache::HashId(id))) {
+        return;
+    }
+
+    bool armTimer = false;
+    {
+        std::lock_guard<std::mutex> lock(batchMutex);
+        pendingBatch[id.Platform].push_back(id);
+        if (!batchTimerArmed) {
+            batchTimerArmed = true;
+            armTimer = true;
+        }
+    }
+
+    if (armTimer) {
+        gameWrapper->SetTimeout([this](GameWrapper* gw) {
+            FlushBatch();
+        }, RLProfilePicturesConstants::AVATAR_BATCH_WINDOW);
+    }
+}
+
+void AvatarDownloader::DownloadAvatars(const std::vector<FUniqueNetId>& ids) {
+    if (ids.empty())
+        return;
+
+    // Queue everything first so per-platform IDs coalesce into bulk requests,
+    // then flush immediately: the caller already knows the full set, so there
+    // is no point waiting out the batching window. Requests are asynchronous,
+    // so platforms (and any single-ID fallbacks) all run concurrently.
+    for (const FUniqueNetId& id : ids) {
+        EnqueueAvatar(id);
+    }
+    FlushBatch();
+}
+
+void AvatarDownloader::FlushBatch() {
+    std::map<uint8_t, std::vector<FUniqueNetId>> batch;
+    {
+        std::lock_guard<std::mutex> lock(batchMutex);
+        batch.swap(pendingBatch);
+        batchTimerArmed = false;
+    }
+
+    for (auto& [platform, ids] : batch) {
+        if (ids.empty()) continue;
+
+        // A lone ID gains nothing from the bulk endpoint
+        if (ids.size() == 1) {
+            EndRequest(AvatarCache::HashId(ids.front()));
+            DownloadAvatar(ids.front());
+            continue;
+        }
+
+        const char* slug = PlatformSlug(static_cast<EOnlinePlatform>(platform));
+        if (!slug) continue;
+
+        static const std::string kBulkPrefix = ApiPrefix(RLProfilePicturesConstants::API_BULK_RETRIEVE);
+        std::string url = kBulkPrefix + slug + "?user_ids=";
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (i > 0) url += ",";
+            url += IdStringForBatch(ids[i]);
+        }
+        // Same flag the single-ID URLs carry, so a not-found player comes
+        // back as the platform default instead of found=false (which would
+        // negative-cache them for the TTL with defaults enabled)
+        url += "&default_enabled=";
+        url += cvLoadDefaults.load(std::memory_order_relaxed) ? "true" : "false";
+
+        RLPP_LOG_DEBUG("Bulk avatar request for " + std::to_string(ids.size()) +
+                                         " " + slug + " players");
+
+        AvatarHttpClient::Instance().SendGet(url, [this, ids](int http_code, char* data_ptr, size_t data_size) {
+            for (const FUniqueNetId& id : ids) {
+                EndRequest(AvatarCache::HashId(id));
+            }
+
+            if (http_code != 200 || data_ptr == nullptr || data_size == 0) {
+                RLPP_LOG_DEBUG("Bulk avatar request failed with code: " +
+                                                 std::to_string(http_code) + ", falling back to single requests");
+                for (const FUniqueNetId& id : ids) {
+                    DownloadAvatar(id);
+                }
+                return;
+            }
+
+            std::string json(data_ptr, data_ptr + data_size);
+
+            // Walk the results array object by object and fan out matches
+            for (const FUniqueNetId& id : ids) {
+                std::string idString = IdStringForBatch(id);
+                size_t objPos = json.find("\"user_id\":\"" + idString + "\"");
+                if (objPos == std::string::npos) continue;
+                size_t objEnd = json.find('}', objPos);
+                if (objEnd == std::string::npos) objEnd = json.size();
+
+                std::string encoded = ExtractJsonString(json, "avatar_data", objPos, objEnd);
+                if (encoded.empty()) {
+                    MarkNegative(AvatarCache::HashId(id));
+                    continue;
+                }
+
+                std::vector<uint8_t> decoded = DecodeBase64(encoded);
+                if (decoded.empty()) {
+                    MarkNegative(AvatarCache::HashId(id));
+                    continue;
+                }
+
+                auto data = std::make_shared<const std::vector<uint8_t>>(std::move(decoded));
+                uint64_t cacheKey = AvatarCache::HashId(id);
+                byteCache.Put(cacheKey, data);
+                AvatarCache::StoreToDisk(cacheKey, *data); // still on the HTTP thread
+
+                gameWrapper->Execute([this, id, data = std::move(data)](GameWrapper* gw) {
+                    RLProfilePicturesLogger::LogSuccess("Avatar downloaded (bulk) for ID: " +
+                                                       UOnline_X::UniqueNetIdToString(id).ToString());
+                    manager->LoadAvatar(id, data);
+                });
+            }
+        });
+    }
+}
+
+void AvatarDownloader::DownloadXboxAvatar(FUniqueNetId id, std::string_view playername) {
+    std::string url = std::format("{}{}?default_enabled={}",
+                                  kPlatforms[static_cast<size_t>(EOnlinePlatform::OnlinePlatform_Dingo)].prefix,
+                                  playername,
+                                  cvLoadDefaults.load(std::memory_order_relaxed) ? "true" : "false");
+    // The ID string only feeds debug logging; skip the SDK FString
+    // conversion entirely when debug logs are off
+    const bool debugLogs = RLProfilePicturesLogger::IsDebugEnabled();
+    auto idStr = [&id] { return UOnline_X::UniqueNetIdToString(id).ToString(); };
+
+    // Serve from the byte cache when we've already downloaded this player
+    uint64_t cacheKey = AvatarCache::HashId(id);
+    if (auto cached = byteCache.Get(cacheKey)) {
+        if (debugLogs) RLProfilePicturesLogger::LogDebug("Avatar byte-cache hit for ID: " + idStr());
+        gameWrapper->Execute([this, id, cached = std::move(cached)](GameWrapper* gw) {
+            manager->LoadAvatar(id, cached);
+        });
+        return;
+    }
+
+    if (IsNegativeCached(cacheKey)) {
+        if (debugLogs) RLProfilePicturesLogger::LogDebug("Negative-cache hit for ID: " + idStr() + ", skipping request");
+        return;
+    }
+
+    if (TryServeFromDisk(id, cacheKey)) {
+        if (debugLogs) RLProfilePicturesLogger::LogDebug("Avatar disk-cache hit for ID: " + idStr());
+        return;
+    }
+
+    if (!TryBeginRequest(cacheKey)) {
+        if (debugLogs) RLProfilePicturesLogger::LogDebug("Request already in flight for ID: " + idStr() + ", skipping duplicate");
+        return;
+    }
+
+    // Capture the small POD id, not the string; reconstruct only when logging
+    AvatarHttpClient::Instance().SendGet(url, [this, id, cacheKey](int http_code, char* data_ptr, size_t data_size) {
+        EndRequest(cacheKey);
+        const bool debugLogs = RLProfilePicturesLogger::IsDebugEnabled();
+        auto idStr = [&id] { return UOnline_X::UniqueNetIdToString(id).ToString(); };
+        if (debugLogs) {
+            RLPP_LOG_DEBUG("HTTP response for ID " + idStr() + ": code=" +
+                                             std::to_string(http_code) + ", size=" + std::to_string(data_size));
+        }
+
         if (http_code != 200) {
-            RLProfilePicturesLogger::LogDebug("HTTP request failed for ID " + idString + 
-                                             " with code: " + std::to_string(http_code));
+            if (debugLogs) {
+                RLPP_LOG_DEBUG("HTTP request failed for ID " + idStr() +
+                                                 " with code: " + std::to_string(http_code));
+            }
+            MarkNegative(cacheKey);
             return;
         }
-        
+
         if (data_ptr == nullptr || data_size == 0) {
-            RLProfilePicturesLogger::LogDebug("No data received for ID: " + idString);
+            if (debugLogs) RLProfilePicturesLogger::LogDebug("No data received for ID: " + idStr());
+            MarkNegative(cacheKey);
             return;
         }
-        
-        std::vector<uint8_t> data(data_ptr, data_ptr + data_size);
-        
+
+        auto buffer = ByteBufferPool::Instance().Acquire();
+        buffer->assign(data_ptr, data_ptr + data_size);
+        std::shared_ptr<const std::vector<uint8_t>> data = buffer;
+        byteCache.Put(cacheKey, data);
+        AvatarCache::StoreToDisk(cacheKey, *data); // still on the HTTP thread
+
         // Use gameWrapper->Execute to ensure we're on the game thread
-        gameWrapper->Execute([this, id, data](GameWrapper* gw) {
+        gameWrapper->Execute([this, id, data = std::move(data)](GameWrapper* gw) {
             RLProfilePicturesLogger::LogSuccess("Avatar downloaded for ID: " + 
                                                UOnline_X::UniqueNetIdToString(id).ToString());
-            if (loadAvatarCallback) {
-                loadAvatarCallback(id, data);
-            }
+            manager->LoadAvatar(id, data);
         });
     });
 }
 
 void AvatarDownloader::UploadToCDN(const std::filesystem::path& filePath,
-    const std::string& epic_id,
+    std::string epic_id,
     std::function<void(bool)> callback) {
     if (filePath.empty() || epic_id.empty()) {
         RLProfilePicturesLogger::LogError("File path or Epic ID is empty, cannot upload avatar.");
@@ -178,8 +550,8 @@ void AvatarDownloader::UploadToCDN(const std::filesystem::path& filePath,
     std::string filePathString = RLProfilePicturesFileUtils::WStringToUtf8(filePath.c_str()); // .string() crashes if file path contains unicode characters on Windows, soo it's safer to first get it into native and then convert.
 
     CurlRequest req;
-    req.url = std::string(RLProfilePicturesConstants::API_BASE_URL) +
-        RLProfilePicturesConstants::API_EPIC_UPLOAD + epic_id;
+    static const std::string kUploadPrefix = ApiPrefix(RLProfilePicturesConstants::API_EPIC_UPLOAD);
+    req.url = kUploadPrefix + epic_id;
     req.verb = "POST";
     req.headers["accept"] = "application/json";
 
@@ -189,12 +561,11 @@ void AvatarDownloader::UploadToCDN(const std::filesystem::path& filePath,
     fileField.data = filePathString;
     req.form_data.push_back(fileField);
 
-    HttpWrapper::SendCurlRequest(req, [epic_id, filePath, callback](int http_code, std::string data) {
+    HttpWrapper::SendCurlRequest(req, [epic_id = std::move(epic_id), filePath, callback](int http_code, std::string data) {
         bool success = false;
 
         if (!data.empty() && http_code == 200) {
-            if (data.find("\"success\":true") != std::string::npos ||
-                (data.find("success") != std::string::npos && data.find("true") != std::string::npos)) {
+            if (ExtractJsonBool(data, "success")) {
                 success = true;
                 RLProfilePicturesLogger::LogSuccess("Avatar uploaded successfully for Epic ID: " + epic_id);
             }
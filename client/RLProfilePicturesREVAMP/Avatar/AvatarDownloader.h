@@ -1,13 +1,23 @@
 #pragma once
 
 #include "RLSDK/SdkHeaders.hpp"
+#include "AvatarCache.h"
 #include <string>
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <atomic>
+#include <array>
+#include <string_view>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 
-// Forward declaration
+// Forward declarations
 class GameWrapper;
+class AvatarManager;
 
 // =============================================================================
 // AVATAR DOWNLOADER
@@ -16,8 +26,126 @@ class GameWrapper;
 class AvatarDownloader {
 private:
     std::shared_ptr<GameWrapper> gameWrapper;
-    std::function<void(FUniqueNetId, const std::vector<uint8_t>&)> loadAvatarCallback;
-    
+
+    // Completions always go to AvatarManager::LoadAvatar; a direct pointer
+    // avoids the std::function allocation and per-call indirection
+    AvatarManager* manager;
+
+    // Raw downloaded bytes, so re-seeing a player skips the HTTP path entirely
+    AvatarCache byteCache;
+
+    // CVar values mirrored into atomics, so the per-player hot paths
+    // (IsAllowed/GetURLForID) read a flag instead of doing a CVar lookup
+    std::atomic<bool> cvLoadDefaults{ true };
+    std::atomic<bool> cvSteamEnabled{ true };
+    std::atomic<bool> cvEpicEnabled{ true };
+    std::atomic<bool> cvXboxEnabled{ true };
+    std::atomic<bool> cvPsnEnabled{ true };
+    std::atomic<bool> cvSwitchEnabled{ true };
+
+    // Whether the local player is on Steam; resolved once since the local
+    // platform cannot change within a session (-1 = not resolved yet)
+    std::atomic<int> localOnSteamCached{ -1 };
+
+    // Per-platform dispatch row: full retrieve URL prefix (base URL +
+    // endpoint, concatenated once at startup), the enabled flag it is
+    // gated on, and how the player ID is rendered into the URL
+    struct PlatformDesc {
+        enum class IdForm : uint8_t { None, Uid, Epic, XboxName };
+        std::string prefix;
+        std::atomic<bool> AvatarDownloader::* enabled = nullptr;
+        IdForm form = IdForm::None;
+    };
+
+    // Indexed by EOnlinePlatform ordinal; rows without an enabled flag are
+    // unsupported platforms. Defined in the .cpp next to GetURLForID.
+    static const std::array<PlatformDesc, 12> kPlatforms;
+
+    /**
+     * Seeds an atomic from a registered CVar and keeps it in sync via
+     * the CVar's change callback
+     * @param name CVar name (must already be registered)
+     * @param target Atomic receiving the value
+     */
+    static void BindCvar(const char* name, std::atomic<bool>& target);
+
+    /**
+     * Checks (and caches) whether the local player is on Steam
+     * @return true if the primary player's platform is Steam
+     */
+    bool IsLocalOnSteam();
+
+    // Players whose last lookup failed/was empty, so we stop hammering the API
+    std::unordered_map<uint64_t, std::chrono::steady_clock::time_point> negativeCache;
+    std::mutex negativeMutex;
+
+    // IDs with a request already on the wire; duplicates are dropped since the
+    // single completion loads the avatar for everyone
+    std::unordered_set<uint64_t> inflight;
+    std::mutex inflightMutex;
+
+    /**
+     * Marks a key as having a request in flight
+     * @param key Cache key from AvatarCache::HashId
+     * @return false if a request for this key is already outstanding
+     */
+    bool TryBeginRequest(uint64_t key);
+
+    /**
+     * Clears the in-flight marker once a request completes (any outcome)
+     * @param key Cache key from AvatarCache::HashId
+     */
+    void EndRequest(uint64_t key);
+
+    /**
+     * Checks whether a recent lookup for this key failed; expired entries
+     * are evicted lazily during the check
+     * @param key Cache key from AvatarCache::HashId
+     * @return true if the failure is still fresh and the request should be skipped
+     */
+    bool IsNegativeCached(uint64_t key);
+
+    /**
+     * Records a failed/empty lookup for this key
+     * @param key Cache key from AvatarCache::HashId
+     */
+    void MarkNegative(uint64_t key);
+
+    /**
+     * Serves a player from the persistent disk cache if a fresh entry exists,
+     * promoting it into the in-memory cache and dispatching the callback
+     * @param id The unique network ID
+     * @param cacheKey Cache key from AvatarCache::HashId
+     * @return true if the avatar was served and no download is needed
+     */
+    bool TryServeFromDisk(FUniqueNetId id, uint64_t cacheKey);
+
+    // Pending batch of IDs per platform, flushed after a short coalescing window
+    std::map<uint8_t, std::vector<FUniqueNetId>> pendingBatch;
+    std::mutex batchMutex;
+    bool batchTimerArmed = false;
+
+    /**
+     * Sends one bulk request per platform for all queued IDs and fans the
+     * results out to AvatarManager::LoadAvatar
+     */
+    void FlushBatch();
+
+    /**
+     * Gets the server-side platform slug used in bulk URLs
+     * @param platform The platform enum value
+     * @return Slug such as "steam", or nullptr if the platform has no bulk endpoint
+     */
+    static const char* PlatformSlug(EOnlinePlatform platform);
+
+    /**
+     * Gets the ID string the API expects for a given unique network ID
+     * @param id The unique network ID
+     * @return Numeric UID string, or the Epic account ID for Epic players
+     */
+    static std::string IdStringForBatch(const FUniqueNetId& id);
+
+
     /**
      * Generates the appropriate API URL for a given unique network ID
      * @param id The unique network ID
@@ -37,10 +165,9 @@ public:
     /**
      * Constructor
      * @param gw GameWrapper instance for thread-safe operations
-     * @param callback Function to call when avatar data is downloaded
+     * @param manager Owning manager that receives downloaded avatar data
      */
-    AvatarDownloader(std::shared_ptr<GameWrapper> gw, 
-                    std::function<void(FUniqueNetId, const std::vector<uint8_t>&)> callback);
+    AvatarDownloader(std::shared_ptr<GameWrapper> gw, AvatarManager* manager);
     
     /**
      * Downloads an avatar for the specified unique network ID
@@ -50,7 +177,26 @@ public:
      * @param id The unique network ID to download avatar for
      */
     void DownloadAvatar(FUniqueNetId id);
-    
+
+    /**
+     * Queues an avatar download and coalesces IDs requested within a short
+     * window into a single bulk API request per platform
+     * Falls back to DownloadAvatar when only one ID is queued
+     *
+     * @param id The unique network ID to download avatar for
+     */
+    void EnqueueAvatar(FUniqueNetId id);
+
+    /**
+     * Downloads avatars for a whole set of players at once (e.g. everyone in
+     * the lobby). All requests go on the wire together so total wall time is
+     * bounded by the slowest response rather than the sum
+     *
+     * @param ids The unique network IDs to download avatars for
+     */
+    void DownloadAvatars(const std::vector<FUniqueNetId>& ids);
+
+
     /**
      * Downloads an Xbox avatar using the player's display name
      * Xbox platform requires player names instead of numeric IDs
@@ -59,7 +205,7 @@ public:
      * @param id The unique network ID 
      * @param playername The Xbox player's display name
      */
-    void DownloadXboxAvatar(FUniqueNetId id, std::string playername);
+    void DownloadXboxAvatar(FUniqueNetId id, std::string_view playername);
     
     /**
      * Uploads a local avatar image to the CDN for Epic players
@@ -67,6 +213,6 @@ public:
      * @param epic_id Epic account ID string
      */
     void UploadToCDN(const std::filesystem::path& filePath,
-        const std::string& epic_id,
+        std::string epic_id,
         std::function<void(bool)> callback);
 };
@@ -0,0 +1,27 @@
+#include "pch.h"
+#include "AvatarHttpClient.h"
+#include "../Utils/Logger.h"
+
+// =============================================================================
+// AVATAR HTTP CLIENT
+// =============================================================================
+
+AvatarHttpClient& AvatarHttpClient::Instance() {
+    static AvatarHttpClient instance;
+    return instance;
+}
+
+void AvatarHttpClient::SendGet(const std::string& url, BinaryCallback callback) {
+    CurlRequest req;
+    req.url = url;
+    req.verb = "GET";
+    // All avatar endpoints share one host; ask the transport to keep the
+    // connection open so follow-up fetches skip DNS/TCP/TLS setup.
+    req.headers["Connection"] = "keep-alive";
+
+    HttpWrapper::SendCurlRequest(req, [callback](int http_code, char* data_ptr, size_t data_size) {
+        if (callback) {
+            callback(http_code, data_ptr, data_size);
+        }
+    });
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <functional>
+
+// =============================================================================
+// AVATAR HTTP CLIENT
+// =============================================================================
+
+/**
+ * Central HTTP client for all avatar API traffic.
+ *
+ * Every avatar request hits the same API_BASE_URL host, so funneling them
+ * through one place lets the transport reuse the established TCP/TLS
+ * connection (keep-alive) instead of paying a fresh handshake per player.
+ * BakkesMod's HttpWrapper owns the underlying curl handles, so connection
+ * reuse is requested via headers rather than raw CURLM options. The HTTP
+ * version is likewise the wrapper's choice: HTTP/2 multiplexing would need
+ * CURLOPT_HTTP_VERSION on its handles, which plugins cannot reach, and ALPN
+ * negotiation cannot be forced from the request header map.
+ */
+class AvatarHttpClient {
+public:
+    // Raw binary response callback: (http_code, data, size)
+    using BinaryCallback = std::function<void(int, char*, size_t)>;
+
+    /**
+     * Gets the process-wide client instance
+     * @return Reference to the singleton
+     */
+    static AvatarHttpClient& Instance();
+
+    /**
+     * Sends a GET request for avatar data with keep-alive enabled
+     * The callback is invoked on the HTTP worker thread
+     *
+     * @param url Full request URL
+     * @param callback Called with the HTTP code and response bytes
+     */
+    void SendGet(const std::string& url, BinaryCallback callback);
+
+    // Non-copyable singleton
+    AvatarHttpClient(const AvatarHttpClient&) = delete;
+    AvatarHttpClient& operator=(const AvatarHttpClient&) = delete;
+
+private:
+    AvatarHttpClient() = default;
+};
@@ -1,217 +1,235 @@
 ﻿#include "pch.h"
 #include "AvatarManager.h"
 #include "ImageProcessor.h"
+#include "ByteBufferPool.h"
 #include "../Config/Constants.h"
 #include "../Utils/Logger.h"
 #include "../Utils/FileUtils.h"
 #include "../Utils/StringUtils.h"
 #include "../RocketLeague/RLObjects.h"
 #include <fstream>
-#include <future>
 #include <thread>
 #include <iostream>
+#include <cwchar>
 
 // =============================================================================
 // AVATAR MANAGER IMPLEMENTATION
 // Good luck to anyone reading this, may god help you :D
 // =============================================================================
 
+namespace {
+    // Compares two Epic account IDs in place. Converting both sides through
+    // ToString() allocated two std::strings per PRI visit, and
+    // FString::operator== can't be used here because it reports two
+    // empty/unset strings as unequal (every non-Epic player has one)
+    bool EpicIdEqual(const FString& a, const FString& b) {
+        const bool aSet = !a.empty() && a.isValid();
+        const bool bSet = !b.empty() && b.isValid();
+        if (!aSet || !bSet) {
+            return aSet == bSet;
+        }
+        return wcscmp(a.c_str(), b.c_str()) == 0;
+    }
+}
+
 AvatarManager::AvatarManager(std::shared_ptr<GameWrapper> gw) : gameWrapper(gw) {
-    // Create downloader with callback to LoadAvatar
-    downloader = std::make_unique<AvatarDownloader>(gw,
-        [this](FUniqueNetId id, const std::vector<uint8_t>& data) {
-            this->LoadAvatar(id, data);
-        });
+    // Downloader feeds completed downloads straight into LoadAvatar
+    downloader = std::make_unique<AvatarDownloader>(gw, this);
+
+    // Mirror the brightness CVar into the atomic once; it stays current via
+    // the change callback instead of being re-queried for every image
+    extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
+    if (_globalCvarManager) {
+        CVarWrapper brightnessCvar = _globalCvarManager->getCvar(RLProfilePicturesConstants::CVAR_BRIGHTNESS_ADJUSTMENT_ENABLED);
+        if (brightnessCvar) {
+            brightnessEnabled.store(brightnessCvar.getBoolValue(), std::memory_order_relaxed);
+            brightnessCvar.addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                brightnessEnabled.store(cvar.getBoolValue(), std::memory_order_relaxed);
+                });
+        }
+    }
 }
 
 AvatarManager::~AvatarManager() {
     ClearCache();
 }
 
-std::shared_ptr<bool> AvatarManager::GetBrightnessEnabled() {
-    extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
-    if (!_globalCvarManager) {
-        RLProfilePicturesLogger::LogDebug("CVarManager not available");
-        return nullptr;
+UTexture2DDynamic* AvatarManager::CreateTextureFromBytes(const std::vector<uint8_t>& pngData, const std::string& idString) {
+    // ImageWrapper has no memory-buffer constructor, so the bytes still go
+    // through a temp file — but exactly once: one write, one read by the
+    // loader, no flush and no verification re-open in between. The path is
+    // kept as a native wide string; the ofstream opens it directly and a
+    // filesystem::path is only materialized for the ImageWrapper call
+    std::wstring filePathW = RLProfilePicturesFileUtils::GetTempAvatarPathW(idString);
+    std::string filePathString = RLProfilePicturesFileUtils::WStringToUtf8(filePathW); // .string() crashes if file path contains unicode characters on Windows, soo it's safer to first get it into native and then convert.
+
+    {
+        std::ofstream out(filePathW.c_str(), std::ios::binary);
+        if (!out) {
+            RLPP_LOG_DEBUG("Failed to open file for writing: " + filePathString);
+            return nullptr;
+        }
+        out.write(reinterpret_cast<const char*>(pngData.data()), pngData.size());
+        if (!out.good()) {
+            RLPP_LOG_DEBUG("Failed to write data to file: " + filePathString);
+            return nullptr;
+        }
     }
 
-    CVarWrapper brightnessCvar = _globalCvarManager->getCvar(RLProfilePicturesConstants::CVAR_BRIGHTNESS_ADJUSTMENT_ENABLED);
-    if (!brightnessCvar) {
-        RLProfilePicturesLogger::LogDebug("Brightness adjustment CVar not found");
+    std::filesystem::path filePath(std::move(filePathW));
+    auto img = std::make_unique<ImageWrapper>(filePath, true, false);
+    if (!img->LoadForCanvas()) {
+        RLPP_LOG_DEBUG("Failed to load image from file: " + filePathString);
+        RLProfilePicturesFileUtils::RemoveAsync(std::move(filePath));
         return nullptr;
     }
 
-    return std::make_shared<bool>(brightnessCvar.getBoolValue());
+    // Clean up temporary file off the game thread
+    RLProfilePicturesFileUtils::RemoveAsync(std::move(filePath));
+
+    UTexture2DDynamic* tex = static_cast<UTexture2DDynamic*>(img->GetCanvasTex());
+    if (!tex) {
+        RLPP_LOG_DEBUG("Failed to get texture from image: " + filePathString);
+    }
+    return tex;
 }
 
 void AvatarManager::AddLocalAvatar(const std::filesystem::path& filePath) {
     APlayerControllerBase_TA* pc = RL::GetPlayerController();
     UVanitySetManager_TA* vman = RL::GetVanitySetManager();
     if (!pc || !vman) {
-        RLProfilePicturesLogger::LogDebug("AddLocalAvatar: PlayerController or VanityManager missing");
+        RLPP_LOG_DEBUG("AddLocalAvatar: PlayerController or VanityManager missing");
         return;
     }
 
-    FUniqueNetId uniqueId = RL::GetPrimaryPlayerID() ? *RL::GetPrimaryPlayerID() : FUniqueNetId{};
+    FUniqueNetId* primaryId = RL::GetPrimaryPlayerID();
+    FUniqueNetId uniqueId = primaryId ? *primaryId : FUniqueNetId{};
     if (!uniqueId.Uid && uniqueId.EpicAccountId.ToString().empty()) {
-        RLProfilePicturesLogger::LogDebug("AddLocalAvatar: Invalid UniqueID");
+        RLPP_LOG_DEBUG("AddLocalAvatar: Invalid UniqueID");
         return;
     }
 
     std::string filePathString = RLProfilePicturesFileUtils::WStringToUtf8(filePath.c_str()); // .string() crashes if file path contains unicode characters on Windows, soo it's safer to first get it into native and then convert.
 
-    try {
-        // Read original file
-        std::ifstream file(filePath, std::ios::binary);
-        if (!file.good()) {
-            RLProfilePicturesLogger::LogError("Cannot read file: " + filePathString);
-            return;
-        }
-        std::vector<uint8_t> originalData((std::istreambuf_iterator<char>(file)),
-            std::istreambuf_iterator<char>());
-        file.close();
-
-        // Process
-        auto brightnessEnabled = GetBrightnessEnabled();
-        std::vector<uint8_t> processedData =
-            RLProfilePicturesImageProcessor::BrightenImage(originalData, brightnessEnabled);
-
-        // Apply avatar within gameWrapper context (no cache clearing or removal to prevent flickering)
-        gameWrapper->Execute([this, uniqueId, processedData, filePath](GameWrapper* gw) {
-            try {
-                // Get ID string in proper context
-                std::string idString = RLProfilePicturesStringUtils::SanitizeFilename(
-                    UOnline_X::UniqueNetIdToString(uniqueId).ToString());
-
-                // For Epic platform: Upload to CDN, then load locally
-                if (static_cast<EOnlinePlatform>(uniqueId.Platform) == EOnlinePlatform::OnlinePlatform_Epic) {
-                    RLProfilePicturesLogger::LogInfo("Uploading processed avatar to CDN...");
-
-                    // Save processed data to temp file for upload
-                    std::filesystem::path tempPath = RLProfilePicturesFileUtils::GetBrightenedLocalAvatarPath();
-                    std::string temoPathString = RLProfilePicturesFileUtils::WStringToUtf8(tempPath.c_str()); // .string() crashes if file path contains unicode characters on Windows, soo it's safer to first get it into native and then convert.
-
-                    {
-                        std::ofstream tempFile(tempPath, std::ios::binary);
-                        if (!tempFile.good()) {
-                            RLProfilePicturesLogger::LogError("Cannot create temp file: " + temoPathString);
-                            return;
-                        }
-                        tempFile.write(reinterpret_cast<const char*>(processedData.data()), processedData.size());
+    // This runs from UI callbacks that are already on the game thread, and
+    // decode + brighten + re-encode of a large image takes hundreds of ms.
+    // The whole read/process/upload chain therefore runs on a worker; only
+    // LoadAvatarDirect (UE-object mutation) hops back via gameWrapper->Execute
+    std::thread([this, uniqueId, filePath, filePathString]() {
+        try {
+            // Read original file in one call into a pooled buffer: sizing up
+            // front and doing a single read() avoids the byte-by-byte
+            // istreambuf_iterator copy, and the pool hands the allocation back
+            // for the next load instead of freeing it
+            std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+            if (!file.good()) {
+                RLProfilePicturesLogger::LogError("Cannot read file: " + filePathString);
+                return;
+            }
+            auto fileSize = static_cast<size_t>(file.tellg());
+            file.seekg(0);
+            auto originalData = ByteBufferPool::Instance().Acquire();
+            originalData->resize(fileSize);
+            if (fileSize == 0 || !file.read(reinterpret_cast<char*>(originalData->data()), fileSize)) {
+                RLProfilePicturesLogger::LogError("Cannot read file: " + filePathString);
+                return;
+            }
+            file.close();
+
+            // Process. The result is moved into a shared_ptr once so the chain
+            // of lambdas below shares one image-sized buffer instead of each
+            // capture taking its own full copy
+            auto dataCopy = std::make_shared<std::vector<uint8_t>>(
+                RLProfilePicturesImageProcessor::BrightenImage(
+                    std::move(*originalData), brightnessEnabled.load(std::memory_order_relaxed)));
+
+            // For Epic platform: Upload to CDN, then load locally
+            if (static_cast<EOnlinePlatform>(uniqueId.Platform) == EOnlinePlatform::OnlinePlatform_Epic) {
+                RLProfilePicturesLogger::LogInfo("Uploading processed avatar to CDN...");
+
+                // Already off the game thread, so the temp file for the
+                // upload can be written right here
+                std::filesystem::path tempPath = RLProfilePicturesFileUtils::GetBrightenedLocalAvatarPath();
+                std::string tempPathString = RLProfilePicturesFileUtils::WStringToUtf8(tempPath.c_str()); // .string() crashes if file path contains unicode characters on Windows, soo it's safer to first get it into native and then convert.
+
+                {
+                    std::ofstream tempFile(tempPath, std::ios::binary);
+                    if (!tempFile.good()) {
+                        RLProfilePicturesLogger::LogError("Cannot create temp file: " + tempPathString);
+                        return;
                     }
-
-                    // Copy data to shared_ptr for safe lambda capture
-                    auto dataCopy = std::make_shared<std::vector<uint8_t>>(processedData);
-
-                    // Upload to CDN, then apply locally (using already-processed data)
-                    downloader->UploadToCDN(
-                        tempPath,
-                        uniqueId.EpicAccountId.ToString(),
-                        [this, uniqueId, dataCopy, tempPath](bool success) {
-                            if (success) {
-                                RLProfilePicturesLogger::LogInfo("Upload complete -> applying local processed image");
-                            }
-                            else {
-                                RLProfilePicturesLogger::LogError("Upload failed, but applying local image anyway");
-                            }
-
-                            // Apply within gameWrapper context
-                            gameWrapper->Execute([this, uniqueId, dataCopy](GameWrapper* gw) {
-                                std::string idStr = RLProfilePicturesStringUtils::SanitizeFilename(
-                                    UOnline_X::UniqueNetIdToString(uniqueId).ToString());
-                                LoadAvatarDirect(uniqueId, idStr, *dataCopy, true);
-                                });
-
-                            // Clean up temp file
-                            std::filesystem::remove(tempPath);
-                        });
-                }
-                else {
-                    // Non-Epic -> directly feed processed bytes
-                    RLProfilePicturesLogger::LogDebug("Non-Epic platform: applying processed avatar locally");
-                    LoadAvatarDirect(uniqueId, idString, processedData, true);
+                    tempFile.write(reinterpret_cast<const char*>(dataCopy->data()), dataCopy->size());
                 }
+
+                // Upload to CDN, then apply locally (using already-processed data)
+                downloader->UploadToCDN(
+                    tempPath,
+                    uniqueId.EpicAccountId.ToString(),
+                    [this, uniqueId, dataCopy, tempPath](bool success) {
+                        if (success) {
+                            RLProfilePicturesLogger::LogInfo("Upload complete -> applying local processed image");
+                        }
+                        else {
+                            RLProfilePicturesLogger::LogError("Upload failed, but applying local image anyway");
+                        }
+
+                        // Apply within gameWrapper context
+                        gameWrapper->Execute([this, uniqueId, dataCopy](GameWrapper* gw) {
+                            LoadAvatarDirect(uniqueId, *dataCopy, true);
+                            });
+
+                        // Clean up temp file
+                        std::filesystem::remove(tempPath);
+                    });
             }
-            catch (const std::exception& e) {
-                RLProfilePicturesLogger::LogError("Exception in AddLocalAvatar Execute: " + std::string(e.what()));
+            else {
+                // Non-Epic -> directly feed processed bytes
+                RLPP_LOG_DEBUG("Non-Epic platform: applying processed avatar locally");
+                gameWrapper->Execute([this, uniqueId, dataCopy](GameWrapper* gw) {
+                    LoadAvatarDirect(uniqueId, *dataCopy, true);
+                    });
             }
-            });
-    }
-    catch (const std::exception& e) {
-        RLProfilePicturesLogger::LogError("Exception in AddLocalAvatar: " + std::string(e.what()));
+        }
+        catch (const std::exception& e) {
+            RLProfilePicturesLogger::LogError("Exception in AddLocalAvatar worker: " + std::string(e.what()));
+        }
+    }).detach();
+}
+
+AvatarManager::AvatarEntry& AvatarManager::LookupOrMake(FUniqueNetId id) {
+    auto [it, inserted] = avatar_cache.try_emplace(AvatarCache::HashId(id));
+    AvatarEntry& entry = it->second;
+    if (entry.idStr.empty()) {
+        entry.idStr = UOnline_X::UniqueNetIdToString(id).ToString();
+        entry.sanitized = RLProfilePicturesStringUtils::SanitizeFilename(entry.idStr);
     }
+    return entry;
 }
 
 // Load avatar without re-applying brightness (already processed data)
-void AvatarManager::LoadAvatarDirect(FUniqueNetId id, const std::string& idString, const std::vector<uint8_t>& alreadyProcessedData, bool forceUpdate) {
-    RLProfilePicturesLogger::LogDebug("LoadAvatarDirect called for ID: " + idString +
-        " with data size: " + std::to_string(alreadyProcessedData.size()) + 
+void AvatarManager::LoadAvatarDirect(FUniqueNetId id, const std::vector<uint8_t>& alreadyProcessedData, bool forceUpdate) {
+    AvatarEntry& entry = LookupOrMake(id);
+    RLPP_LOG_DEBUG("LoadAvatarDirect called for ID: " + entry.idStr +
+        " with data size: " + std::to_string(alreadyProcessedData.size()) +
         ", forceUpdate: " + (forceUpdate ? "true" : "false"));
 
     // Check cache first (unless forcing update)
-    UTexture2DDynamic* tex = nullptr;
-    if (!forceUpdate) {
-        auto it = avatar_cache.find(idString);
-        if (it != avatar_cache.end() && it->second) {
-            tex = it->second;
-            RLProfilePicturesLogger::LogDebug("Avatar found in cache for ID: " + idString);
-            SetAvatar(id, tex);
-            return;
-        }
+    if (!forceUpdate && entry.tex) {
+        RLPP_LOG_DEBUG("Avatar found in cache for ID: " + entry.idStr);
+        SetAvatar(id, entry.tex);
+        return;
     }
 
     try {
-        std::filesystem::path filePath = RLProfilePicturesFileUtils::GetTempAvatarPath(idString);
-        std::string filePathString = RLProfilePicturesFileUtils::WStringToUtf8(filePath.c_str()); // .string() crashes if file path contains unicode characters on Windows, soo it's safer to first get it into native and then convert.
-
-        RLProfilePicturesLogger::LogDebug("Attempting to write avatar file: " + filePathString); 
-
-
-        {
-
-            std::ofstream out(filePath, std::ios::binary);
-            if (!out) {
-                RLProfilePicturesLogger::LogDebug("Failed to open file for writing: " + filePathString);
-                return;
-            }
-            out.write(reinterpret_cast<const char*>(alreadyProcessedData.data()), alreadyProcessedData.size());
-            out.flush();
-            if (!out.good()) {
-                RLProfilePicturesLogger::LogDebug("Failed to write data to file: " + filePathString);
-                return;
-            }
-            RLProfilePicturesLogger::LogDebug("Successfully wrote " + std::to_string(alreadyProcessedData.size()) +
-                " bytes to: " + filePathString);
-        }
-
-        // Verify file was created
-        std::ifstream fileCheck(filePath);
-        if (!fileCheck.good()) {
-            RLProfilePicturesLogger::LogDebug("File does not exist after writing: " + filePathString);
-            return;
-        }
-        fileCheck.close();
-
-        auto img = std::make_unique<ImageWrapper>(filePath, true, false);
-        if (!img->LoadForCanvas()) {
-            RLProfilePicturesLogger::LogDebug("Failed to load image from file: " + filePathString);
-            std::filesystem::remove(filePath);
-            return;
-        }
-
-        // Clean up temporary file
-        std::filesystem::remove(filePath);
-
-        tex = static_cast<UTexture2DDynamic*>(img->GetCanvasTex());
+        UTexture2DDynamic* tex = CreateTextureFromBytes(alreadyProcessedData, entry.sanitized);
         if (!tex) {
-            RLProfilePicturesLogger::LogDebug("Failed to get texture from image: " + filePathString);
             return;
         }
 
         // Cache the texture
-        avatar_cache[idString] = tex;
+        entry.tex = tex;
         SetAvatar(id, tex);
-        RLProfilePicturesLogger::LogSuccess("Avatar loaded successfully for ID: " + idString);
+        RLProfilePicturesLogger::LogSuccess("Avatar loaded successfully for ID: " + entry.idStr);
     }
     catch (const std::exception& e) {
         RLProfilePicturesLogger::LogError("Exception in LoadAvatarDirect: " + std::string(e.what()));
@@ -224,7 +242,8 @@ void AvatarManager::RemoveLocalAvatar() {
     UVanitySetManager_TA* vman = RL::GetVanitySetManager();
     if (!pc || !vman) return;
 
-    FUniqueNetId uniqueId = RL::GetPrimaryPlayerID() ? *RL::GetPrimaryPlayerID() : FUniqueNetId{};
+    FUniqueNetId* primaryId = RL::GetPrimaryPlayerID();
+    FUniqueNetId uniqueId = primaryId ? *primaryId : FUniqueNetId{};
     if (!uniqueId.Uid && uniqueId.EpicAccountId.ToString().empty()) return;
 
     UPlayerAvatar_TA* avatar = vman->GetAvatar(uniqueId);
@@ -237,83 +256,40 @@ void AvatarManager::RemoveLocalAvatar() {
     avatar->HandleUpdateTexture(nullptr);
     vman->HandleLoadedAvatarAsset(avatar);
 	// Clear cache entry
-	std::string idString = UOnline_X::UniqueNetIdToString(uniqueId).ToString();
-	avatar_cache.erase(idString);
-    for (const auto& [key, tex] : avatar_cache) {
-        RLProfilePicturesLogger::LogDebug("Cache entry remains: " + key);
+	avatar_cache.erase(AvatarCache::HashId(uniqueId));
+    if (RLProfilePicturesLogger::IsDebugEnabled()) {
+        for (const auto& [key, entry] : avatar_cache) {
+            RLProfilePicturesLogger::LogDebug("Cache entry remains: " + entry.idStr);
+        }
     }
     RLProfilePicturesLogger::LogSuccess("Avatar removed successfully");
 }
 
-void AvatarManager::LoadAvatar(FUniqueNetId id, const std::vector<uint8_t>& data) {
-    std::string idString = RLProfilePicturesStringUtils::SanitizeFilename(
-        UOnline_X::UniqueNetIdToString(id).ToString());
-    RLProfilePicturesLogger::LogDebug("LoadAvatar called for ID: " + idString +
-        " with data size: " + std::to_string(data.size()));
+void AvatarManager::LoadAvatar(FUniqueNetId id, std::shared_ptr<const std::vector<uint8_t>> data) {
+    if (!data) return;
+    AvatarEntry& entry = LookupOrMake(id);
+    RLPP_LOG_DEBUG("LoadAvatar called for ID: " + entry.idStr +
+        " with data size: " + std::to_string(data->size()));
 
     // Check cache first
-    UTexture2DDynamic* tex = nullptr;
-    auto it = avatar_cache.find(idString);
-    if (it != avatar_cache.end() && it->second) {
-        tex = it->second;
-        RLProfilePicturesLogger::LogDebug("Avatar found in cache for ID: " + idString);
-        SetAvatar(id, tex);
+    if (entry.tex) {
+        RLPP_LOG_DEBUG("Avatar found in cache for ID: " + entry.idStr);
+        SetAvatar(id, entry.tex);
         return;
     }
 
     try {
         // Apply brightness adjustment before processing
-        auto brightnessEnabled = GetBrightnessEnabled();
-        std::vector<uint8_t> brightenedData = RLProfilePicturesImageProcessor::BrightenImage(data, brightnessEnabled);
-
-        std::filesystem::path filePath = RLProfilePicturesFileUtils::GetTempAvatarPath(idString);
-        std::string filePathString = RLProfilePicturesFileUtils::WStringToUtf8(filePath.c_str()); // .string() crashes if file path contains unicode characters on Windows, soo it's safer to first get it into native and then convert.
-
-        RLProfilePicturesLogger::LogDebug("Attempting to write brightened avatar file: " + filePathString);
-
-
-        {
-            std::ofstream out(filePath, std::ios::binary);
-            if (!out) {
-                RLProfilePicturesLogger::LogDebug("Failed to open file for writing: " + filePathString);
-                return;
-            }
-            out.write(reinterpret_cast<const char*>(brightenedData.data()), brightenedData.size());
-            out.flush();
-            if (!out.good()) {
-                RLProfilePicturesLogger::LogDebug("Failed to write data to file: " + filePathString);
-                return;
-            }
-            RLProfilePicturesLogger::LogDebug("Successfully wrote " + std::to_string(brightenedData.size()) +
-                " bytes to: " + filePathString);
-        }
-
-        // Verify file was created
-        std::ifstream fileCheck(filePath);
-        if (!fileCheck.good()) {
-            RLProfilePicturesLogger::LogDebug("File does not exist after writing: " + filePathString);
-            return;
-        }
-        fileCheck.close();
-
-        auto img = std::make_unique<ImageWrapper>(filePath, true, false);
-        if (!img->LoadForCanvas()) {
-            RLProfilePicturesLogger::LogDebug("Failed to load image from file: " + filePathString);
-            std::filesystem::remove(filePath);
-            return;
-        }
-
-        // Clean up temporary file
-        std::filesystem::remove(filePath);
+        std::vector<uint8_t> brightenedData = RLProfilePicturesImageProcessor::BrightenImage(
+            *data, brightnessEnabled.load(std::memory_order_relaxed));
 
-        tex = static_cast<UTexture2DDynamic*>(img->GetCanvasTex());
+        UTexture2DDynamic* tex = CreateTextureFromBytes(brightenedData, entry.sanitized);
         if (!tex) {
-            RLProfilePicturesLogger::LogDebug("Failed to get texture from image: " + filePathString);
             return;
         }
 
         // Cache the texture
-        avatar_cache[idString] = tex;
+        entry.tex = tex;
         SetAvatar(id, tex);
     }
     catch (const std::exception& e) {
@@ -321,9 +297,45 @@ void AvatarManager::LoadAvatar(FUniqueNetId id, const std::vector<uint8_t>& data
     }
 }
 
+bool AvatarManager::ApplyToLocalPlayer(FUniqueNetId id, UTexture2DDynamic* tex) {
+    APlayerControllerBase_TA* pc = RL::GetPlayerController();
+    UVanitySetManager_TA* vman = RL::GetVanitySetManager();
+    if (!pc || !vman) {
+        RLPP_LOG_DEBUG("ApplyToLocalPlayer: PlayerController or VanityManager missing");
+        return false;
+    }
+    UPlayerAvatar_TA* avatar = vman->GetAvatar(id);
+    if (!avatar) {
+        RLProfilePicturesLogger::LogError("ApplyToLocalPlayer: No avatar component found!");
+        return false;
+    }
+    pc->PlayerAvatar = avatar;
+    avatar->HandleUpdateTexture(tex);
+    vman->HandleLoadedAvatarAsset(avatar);
+
+    UGFxShell_X* shell = RL::GetShell();
+    if (!shell) {
+        RLPP_LOG_DEBUG("ApplyToLocalPlayer: GFxShell_X missing");
+        return false;
+    }
+    UGFxData_PlayerAvatar_TA* avatarData = UGFxData_PlayerAvatar_TA::GetOrCreate(shell, avatar);
+    if (!avatarData) {
+        RLPP_LOG_DEBUG("ApplyToLocalPlayer: UGFxData_PlayerAvatar_TA missing");
+        return false;
+    }
+    UGFxDataStore_X* dataStore = shell->DataStore;
+    if (!dataStore) {
+        RLPP_LOG_DEBUG("ApplyToLocalPlayer: DataStore missing");
+        return false;
+    }
+    dataStore->SetTextureValue(avatarData->TableName, avatarData->RowIndex, L"ToPlayer", tex);
+    RLProfilePicturesLogger::LogSuccess("SetAvatar: Avatar set successfully for local player");
+    return true;
+}
+
 void AvatarManager::SetAvatar(FUniqueNetId id, UTexture2DDynamic* tex) {
-    std::string idString = UOnline_X::UniqueNetIdToString(id).ToString();
-    RLProfilePicturesLogger::LogDebug("SetAvatar called for ID: " + idString);
+    const std::string& idString = LookupOrMake(id).idStr;
+    RLPP_LOG_DEBUG("SetAvatar called for ID: " + idString);
     UObject* pcObj = reinterpret_cast <UObject*> (gameWrapper->GetPlayerController().memory_address);
     if (!pcObj) {
         RLProfilePicturesLogger::LogError("SetAvatar: gameWrapper->GetPlayerController() returned null");
@@ -336,98 +348,30 @@ void AvatarManager::SetAvatar(FUniqueNetId id, UTexture2DDynamic* tex) {
     APlayerController_TA* pc = Cast < APlayerController_TA >(pcObj);
     if (!pc) {
         RLProfilePicturesLogger::LogError("SetAvatar: PlayerController cast failed, assuming local player");
-        APlayerControllerBase_TA* pc = RL::GetPlayerController();
-        UVanitySetManager_TA* vman = RL::GetVanitySetManager();
-        if (!pc || !vman) {
-            RLProfilePicturesLogger::LogDebug("AddLocalAvatar: PlayerController or VanityManager missing");
-            return;
-        }
-        UPlayerAvatar_TA* avatar = vman->GetAvatar(id);
-        if (!avatar) {
-            RLProfilePicturesLogger::LogError("No avatar component found!");
-            return;
-        }
-        if (!tex) {
-            RLProfilePicturesLogger::LogError("No texture provided to set!");
-            return;
-		}
-        pc->PlayerAvatar = avatar;
-        avatar->HandleUpdateTexture(tex);
-        vman->HandleLoadedAvatarAsset(avatar);
-        UGFxShell_X* shell = RL::GetShell();
-        if (!shell) {
-            RLProfilePicturesLogger::LogDebug("AddLocalAvatar: GFxShell_X missing");
-            return;
-        }
-        UGFxData_PlayerAvatar_TA* avatarData = UGFxData_PlayerAvatar_TA::GetOrCreate(shell, avatar);
-        if (!avatarData) {
-            RLProfilePicturesLogger::LogDebug("AddLocalAvatar: UGFxData_PlayerAvatar_TA missing");
-            return;
-        }
-        UGFxDataStore_X* dataStore = shell->DataStore;
-        if (!dataStore) {
-            RLProfilePicturesLogger::LogDebug("AddLocalAvatar: DataStore missing");
-            return;
-        }
-        dataStore->SetTextureValue(avatarData->TableName, avatarData->RowIndex, L"ToPlayer", tex);
-        RLProfilePicturesLogger::LogSuccess("SetAvatar: Avatar set successfully for local player");
+        ApplyToLocalPlayer(id, tex);
         return;
     }
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Got PlayerController");
+    RLPP_LOG_DEBUG("SetAvatar: Got PlayerController");
     if (!pc->PRI) {
         RLProfilePicturesLogger::LogError("SetAvatar: PlayerController->PRI is null");
         return;
     }
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Got PlayerController->PRI");
+    RLPP_LOG_DEBUG("SetAvatar: Got PlayerController->PRI");
     AGameEvent_TA* event = pc->PRI->GameEvent;
     if (!event) {
         RLProfilePicturesLogger::LogError("SetAvatar: GameEvent is null");
         return;
     }
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Got GameEvent");
+    RLPP_LOG_DEBUG("SetAvatar: Got GameEvent");
     APRI_TA* pri = event->FindPlayerPRI(id);
     if (!pri) {
         RLProfilePicturesLogger::LogError("SetAvatar: Failed to find PRI for ID: " + idString);
         return;
     }
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Found PRI for " + pri->PlayerName.ToString());
+    RLPP_LOG_DEBUG("SetAvatar: Found PRI for " + pri->PlayerName.ToString());
     if (pri->IsLocalPlayerPRI()) {
-        RLProfilePicturesLogger::LogDebug("SetAvatar: Local PRI, using random ahh stuff");
-        UVanitySetManager_TA* vman = RL::GetVanitySetManager();
-        if (!pc || !vman) {
-            RLProfilePicturesLogger::LogDebug("AddLocalAvatar: PlayerController or VanityManager missing");
-            return;
-        }
-        UPlayerAvatar_TA* avatar = vman->GetAvatar(id);
-        if (!avatar) {
-            RLProfilePicturesLogger::LogError("No avatar component found!");
-            return;
-        }
-        if (!tex) {
-            RLProfilePicturesLogger::LogError("No texture provided to set!");
-            return;
-        }
-        pc->PlayerAvatar = avatar;
-        avatar->HandleUpdateTexture(tex);
-        vman->HandleLoadedAvatarAsset(avatar);
-        UGFxShell_X* shell = RL::GetShell();
-        if (!shell) {
-            RLProfilePicturesLogger::LogDebug("AddLocalAvatar: GFxShell_X missing");
-            return;
-        }
-        UGFxData_PlayerAvatar_TA* avatarData = UGFxData_PlayerAvatar_TA::GetOrCreate(shell, avatar);
-        if (!avatarData) {
-            RLProfilePicturesLogger::LogDebug("AddLocalAvatar: UGFxData_PlayerAvatar_TA missing");
-            return;
-        }
-        UGFxDataStore_X* dataStore = shell->DataStore;
-        if (!dataStore) {
-            RLProfilePicturesLogger::LogDebug("AddLocalAvatar: DataStore missing");
-            return;
-        }
-        dataStore->SetTextureValue(avatarData->TableName, avatarData->RowIndex, L"ToPlayer", tex);
-        RLProfilePicturesLogger::LogSuccess("SetAvatar: Avatar set successfully for local player");
-        return;
+        RLPP_LOG_DEBUG("SetAvatar: Local PRI, using random ahh stuff");
+        ApplyToLocalPlayer(id, tex);
         return;
     }
     UVanitySetManager_TA* vanitySet = pc->VanityMgr;
@@ -435,46 +379,46 @@ void AvatarManager::SetAvatar(FUniqueNetId id, UTexture2DDynamic* tex) {
         RLProfilePicturesLogger::LogError("SetAvatar: VanitySetManager is null");
         return;
     }
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Got VanitySetManager");
+    RLPP_LOG_DEBUG("SetAvatar: Got VanitySetManager");
     UPlayerAvatar_TA* avatar = vanitySet->GetAvatar(id);
     if (!avatar) {
         RLProfilePicturesLogger::LogError("SetAvatar: No avatar found in VanitySetManager for ID: " + idString);
         return;
     }
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Got UPlayerAvatar_TA");
+    RLPP_LOG_DEBUG("SetAvatar: Got UPlayerAvatar_TA");
     UGFxShell_TA* shell = RL::GetShell();
     if (!shell) {
         RLProfilePicturesLogger::LogError("SetAvatar: GFxShell is null");
         return;
     }
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Got GFxShell");
+    RLPP_LOG_DEBUG("SetAvatar: Got GFxShell");
     UGFxData_PlayerAvatar_TA* avatarData = UGFxData_PlayerAvatar_TA::GetOrCreate(shell, avatar);
     if (!avatarData) {
         RLProfilePicturesLogger::LogError("SetAvatar: Failed to get or create UGFxData_PlayerAvatar_TA");
         return;
     }
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Got UGFxData_PlayerAvatar_TA");
+    RLPP_LOG_DEBUG("SetAvatar: Got UGFxData_PlayerAvatar_TA");
     UGFxDataStore_X* dataStore = shell->DataStore;
     if (!dataStore) {
         RLProfilePicturesLogger::LogError("SetAvatar: DataStore is null");
         return;
     }
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Got DataStore");
+    RLPP_LOG_DEBUG("SetAvatar: Got DataStore");
     dataStore->SetTextureValue(avatarData->TableName, avatarData->RowIndex, L"ToPlayer", tex);
-    RLProfilePicturesLogger::LogDebug("SetAvatar: SetTextureValue called");
+    RLPP_LOG_DEBUG("SetAvatar: SetTextureValue called");
     pc->PlayerAvatar = avatar;
     avatar->HandleUpdateTexture(tex);
     vanitySet->HandleLoadedAvatarAsset(avatar);
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Avatar texture applied");
+    RLPP_LOG_DEBUG("SetAvatar: Avatar texture applied");
     AGFxHUD_TA* hud = Cast < AGFxHUD_TA >(pc->myHUD);
     if (!hud) {
         RLProfilePicturesLogger::LogError("SetAvatar: HUD is null");
         return;
     }
-    RLProfilePicturesLogger::LogDebug("SetAvatar: Got HUD");
+    RLPP_LOG_DEBUG("SetAvatar: Got HUD");
     UGFxData_PRI_TA* priData = hud->GetPRIDataFromID(id);
     if (priData) {
-        RLProfilePicturesLogger::LogDebug("SetAvatar: Updating PRIData for " + pri->PlayerName.ToString());
+        RLPP_LOG_DEBUG("SetAvatar: Updating PRIData for " + pri->PlayerName.ToString());
         priData->UpdatePRIData();
     }
     else {
@@ -510,13 +454,12 @@ void AvatarManager::ApplyAvatar(UPlayerAvatar_TA* avatar, UTexture2DDynamic* tex
 
     avatar->HandleUpdateTexture(tex);
 
-    RLProfilePicturesLogger::LogDebug("ApplyAvatar: Avatar texture updated successfully");
+    RLPP_LOG_DEBUG("ApplyAvatar: Avatar texture updated successfully");
 }
 
 void AvatarManager::RemoveUserAvatar(FUniqueNetId id) {
     UObject* pcObj = reinterpret_cast<UObject*>(gameWrapper->GetPlayerController().memory_address);
     APlayerController_TA* pc = Cast<APlayerController_TA>(pcObj);
-    std::string idString = UOnline_X::UniqueNetIdToString(id).ToString();
     AGameEvent_TA* event = pc->PRI->GameEvent;
     if (!event) return;
     APRI_TA* pri = event->FindPlayerPRI(id);
@@ -527,10 +470,12 @@ void AvatarManager::RemoveUserAvatar(FUniqueNetId id) {
 	if (!vanitySet) return;
     if (!avatar) return;
 
-    UGFxData_PlayerAvatar_TA* avatarData = UGFxData_PlayerAvatar_TA::GetOrCreate(RL::GetShell(), avatar);
-    UGFxDataStore_X* dataStore = RL::GetShell()->DataStore;
+    UGFxShell_TA* shell = RL::GetShell();
+    if (!shell) return;
+    UGFxData_PlayerAvatar_TA* avatarData = UGFxData_PlayerAvatar_TA::GetOrCreate(shell, avatar);
+    UGFxDataStore_X* dataStore = shell->DataStore;
 
-    if (!dataStore) return;
+    if (!avatarData || !dataStore) return;
     dataStore->SetTextureValue(avatarData->TableName, avatarData->RowIndex, L"ToPlayer", nullptr);
 
     pri->PlayerAvatar = nullptr;
@@ -552,7 +497,7 @@ void AvatarManager::LoadForPRI(APRI_TA* pri) {
     UObject* pcObj = reinterpret_cast<UObject*>(gameWrapper->GetPlayerController().memory_address);
     APlayerController_TA* pc = Cast<APlayerController_TA>(pcObj);
     if (!pc || !pri) {
-        RLProfilePicturesLogger::LogDebug("LoadForPRI: PlayerController or PRI missing");
+        RLPP_LOG_DEBUG("LoadForPRI: PlayerController or PRI missing");
         return;
     }
 
@@ -561,51 +506,114 @@ void AvatarManager::LoadForPRI(APRI_TA* pri) {
     FUniqueNetId* priId = pri ? &pri->UniqueId : nullptr;
 
     if (!localId || !priId) {
-        RLProfilePicturesLogger::LogDebug("LoadForPRI: LocalID or PRI ID missing");
+        RLPP_LOG_DEBUG("LoadForPRI: LocalID or PRI ID missing");
         return;
     }
-    if (localId->Uid == priId->Uid && localId->EpicAccountId.ToString() == priId->EpicAccountId.ToString()) {
-        RLProfilePicturesLogger::LogDebug("LoadForPRI: Local player detected, skipping");
+    if (localId->Uid == priId->Uid && EpicIdEqual(localId->EpicAccountId, priId->EpicAccountId)) {
+        RLPP_LOG_DEBUG("LoadForPRI: Local player detected, skipping");
         return;
     }
 
     FUniqueNetId uniqueId = pri->UniqueId;
 
-    // Xbox platform requires special handling with player names
+    // Debounce repeat triggers for the same player (name replication and
+    // avatar update often land in the same frame)
+    const uint64_t debounceKey = AvatarCache::HashId(uniqueId);
+    const auto now = std::chrono::steady_clock::now();
+    auto [lastIt, firstLoad] = lastPriLoad.try_emplace(debounceKey, now);
+    if (!firstLoad) {
+        if (now - lastIt->second <
+            std::chrono::milliseconds(RLProfilePicturesConstants::PRI_LOAD_DEBOUNCE_MS)) {
+            RLPP_LOG_DEBUG("LoadForPRI: debounced repeat trigger");
+            return;
+        }
+        lastIt->second = now;
+    }
+
+    // Xbox platform requires special handling with player names. Called
+    // directly like every other platform: the downloader is already
+    // asynchronous (the SDK HTTP wrapper completes on its own thread), and
+    // the std::async wrapper used here before blocked in the dropped
+    // future's destructor anyway, spawning a kernel thread for nothing
     if (static_cast<EOnlinePlatform>(uniqueId.Platform) == EOnlinePlatform::OnlinePlatform_Dingo) {
-        std::string playername = pri->PlayerName.ToString();
-        auto future = std::async(std::launch::async, [this, uniqueId, playername]() {
-            this->downloader->DownloadXboxAvatar(uniqueId, playername);
-            });
+        downloader->DownloadXboxAvatar(uniqueId, pri->PlayerName.ToString());
         return;
     }
 
-    // Check if avatar is already cached
-    std::string idString = UOnline_X::UniqueNetIdToString(uniqueId).ToString();
-    UTexture2DDynamic* tex = GetCachedAvatar(idString);
-    if (tex) {
-        RLProfilePicturesLogger::LogDebug("Using cached avatar for ID: " + idString);
-        SetAvatar(uniqueId, tex);
+    // Check if avatar is already cached; the entry also interns the ID
+    // string so repeated passes over the same lobby stop re-formatting it
+    AvatarEntry& entry = LookupOrMake(uniqueId);
+    if (entry.tex) {
+        RLPP_LOG_DEBUG("Using cached avatar for ID: " + entry.idStr);
+        SetAvatar(uniqueId, entry.tex);
     }
     else {
-        RLProfilePicturesLogger::LogDebug("Downloading avatar for ID: " + idString);
-        auto future = std::async(std::launch::async, [this, uniqueId]() {
-            this->downloader->DownloadAvatar(uniqueId);
-            });
+        RLPP_LOG_DEBUG("Downloading avatar for ID: " + entry.idStr);
+        // Enqueue so nearby requests (whole lobby joining) coalesce into one bulk call
+        downloader->EnqueueAvatar(uniqueId);
+    }
+}
+
+void AvatarManager::LoadForAllPRIs(const std::vector<APRI_TA*>& pris) {
+    UObject* pcObj = reinterpret_cast<UObject*>(gameWrapper->GetPlayerController().memory_address);
+    APlayerController_TA* pc = Cast<APlayerController_TA>(pcObj);
+    if (!pc || !pc->PRI) {
+        RLPP_LOG_DEBUG("LoadForAllPRIs: PlayerController or local PRI missing");
+        return;
+    }
+    FUniqueNetId* localId = &pc->PRI->UniqueId;
+
+    // Partition: cached players are applied on the spot, the rest are
+    // collected and handed to the downloader in one go so they share a
+    // single bulk request per platform
+    std::vector<FUniqueNetId> toDownload;
+    toDownload.reserve(pris.size());
+
+    for (APRI_TA* pri : pris) {
+        if (!pri || pri->IsLocalPlayerPRI()) continue;
+        if (localId->Uid == pri->UniqueId.Uid &&
+            EpicIdEqual(localId->EpicAccountId, pri->UniqueId.EpicAccountId)) {
+            continue;
+        }
+
+        FUniqueNetId uniqueId = pri->UniqueId;
+
+        // Xbox still goes by player name, one request each
+        if (static_cast<EOnlinePlatform>(uniqueId.Platform) == EOnlinePlatform::OnlinePlatform_Dingo) {
+            downloader->DownloadXboxAvatar(uniqueId, pri->PlayerName.ToString());
+            continue;
+        }
+
+        AvatarEntry& entry = LookupOrMake(uniqueId);
+        if (entry.tex) {
+            RLPP_LOG_DEBUG("Using cached avatar for ID: " + entry.idStr);
+            SetAvatar(uniqueId, entry.tex);
+        }
+        else {
+            toDownload.push_back(uniqueId);
+        }
+    }
+
+    if (!toDownload.empty()) {
+        RLPP_LOG_DEBUG("LoadForAllPRIs: batching " + std::to_string(toDownload.size()) + " downloads");
+        downloader->DownloadAvatars(toDownload);
     }
 }
 
 void AvatarManager::ClearCache() {
     avatar_cache.clear();
-    RLProfilePicturesLogger::LogDebug("Avatar cache cleared");
+    // Debounce timestamps reset too, so loads right after a match-start
+    // clear are never suppressed
+    lastPriLoad.clear();
+    RLPP_LOG_DEBUG("Avatar cache cleared");
 }
 
-bool AvatarManager::IsAvatarCached(const std::string& idString) {
-    auto it = avatar_cache.find(idString);
-    return (it != avatar_cache.end() && it->second != nullptr);
+bool AvatarManager::IsAvatarCached(FUniqueNetId id) {
+    auto it = avatar_cache.find(AvatarCache::HashId(id));
+    return (it != avatar_cache.end() && it->second.tex != nullptr);
 }
 
-UTexture2DDynamic* AvatarManager::GetCachedAvatar(const std::string& idString) {
-    auto it = avatar_cache.find(idString);
-    return (it != avatar_cache.end()) ? it->second : nullptr;
+UTexture2DDynamic* AvatarManager::GetCachedAvatar(FUniqueNetId id) {
+    auto it = avatar_cache.find(AvatarCache::HashId(id));
+    return (it != avatar_cache.end()) ? it->second.tex : nullptr;
 }
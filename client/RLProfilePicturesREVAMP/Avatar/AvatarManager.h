@@ -4,8 +4,10 @@
 #include "AvatarDownloader.h"
 #include <string>
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <memory>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 
 // Forward declarations
@@ -20,17 +22,59 @@ private:
     std::shared_ptr<GameWrapper> gameWrapper;
     std::unique_ptr<AvatarDownloader> downloader;
 
-    // Avatar cache: maps ID strings to texture pointers
-    std::map<std::string, UTexture2DDynamic*> avatar_cache;
+    // Avatar cache: maps hashed unique IDs (AvatarCache::HashId) to texture
+    // pointers. A uint64 key makes a lookup one hash probe instead of the
+    // string format + allocate + tree walk the old std::map<std::string>
+    // needed on every hit. Each entry also interns the formatted and
+    // sanitized ID strings, since UniqueNetIdToString and SanitizeFilename
+    // both allocate and were being re-run for the same player on every call
+    struct AvatarEntry {
+        UTexture2DDynamic* tex = nullptr;
+        std::string idStr;      // UniqueNetIdToString form, for logging
+        std::string sanitized;  // filename-safe form, for temp files
+    };
+    std::unordered_map<uint64_t, AvatarEntry> avatar_cache;
+
+    // Last time LoadForPRI ran per player: the ReplicatedEvent and
+    // UpdatePlayerAvatar hooks can both fire for the same PRI within a
+    // frame, and a short debounce collapses the duplicates into one load.
+    // Game-thread only, like the cache above
+    std::unordered_map<uint64_t, std::chrono::steady_clock::time_point> lastPriLoad;
 
     /**
-     * Gets brightness adjustment setting from CVar
-     * @return shared_ptr to brightness enabled setting, or nullptr if not available
+     * Finds or creates the cache entry for an ID, formatting and sanitizing
+     * the ID string exactly once per player
+     * @param id Unique network ID of the player
+     * @return The cache entry (tex may still be null)
      */
-    std::shared_ptr<bool> GetBrightnessEnabled();
+    AvatarEntry& LookupOrMake(FUniqueNetId id);
+
+    // Brightness CVar mirrored into an atomic (seeded in the ctor, kept in
+    // sync by the CVar's change callback) so per-image loads read a flag
+    // instead of doing a CVar registry lookup and a shared_ptr allocation
+    std::atomic<bool> brightnessEnabled{ true };
 
 	void ApplyAvatar(UPlayerAvatar_TA* avatar, UTexture2DDynamic* tex);
 
+    /**
+     * Applies a texture to the local player's avatar component and pushes
+     * it into the GFx data store. Shared by the SetAvatar local-player paths
+     * @param id Unique network ID of the local player
+     * @param tex Texture to apply
+     * @return true if the texture was applied
+     */
+    bool ApplyToLocalPlayer(FUniqueNetId id, UTexture2DDynamic* tex);
+
+    /**
+     * Turns PNG bytes into a canvas texture via ImageWrapper
+     * The SDK's ImageWrapper only loads from file, so the bytes take one
+     * minimal trip through a temp file that is removed immediately after
+     * @param pngData PNG image bytes
+     * @param idString Sanitized ID used for the temp filename and logging
+     * @return The texture, or nullptr on failure
+     */
+    UTexture2DDynamic* CreateTextureFromBytes(const std::vector<uint8_t>& pngData, const std::string& idString);
+
 public:
     /**
      * Constructor
@@ -52,7 +96,7 @@ public:
      */
     void AddLocalAvatar(const std::filesystem::path& filePath);
 
-    void LoadAvatarDirect(FUniqueNetId id, const std::string& idString, const std::vector<uint8_t>& alreadyProcessedData, bool forceUpdate = false);
+    void LoadAvatarDirect(FUniqueNetId id, const std::vector<uint8_t>& alreadyProcessedData, bool forceUpdate = false);
 
     /**
      * Removes the local player's avatar
@@ -66,9 +110,9 @@ public:
      * Must be called from game thread
      *
      * @param id Unique network ID of the player
-     * @param data Raw PNG image data
+     * @param data Raw PNG image data (shared, not copied per consumer)
      */
-    void LoadAvatar(FUniqueNetId id, const std::vector<uint8_t>& data);
+    void LoadAvatar(FUniqueNetId id, std::shared_ptr<const std::vector<uint8_t>> data);
 
     /**
      * Sets an avatar texture for a specific player
@@ -97,6 +141,18 @@ public:
      */
     void LoadForPRI(APRI_TA* pri);
 
+    /**
+     * Processes a whole lobby of PRIs at once
+     * Cached avatars are applied immediately; everything else goes to the
+     * downloader as one batch, so the uncached players share a single bulk
+     * request per platform and total wall time is bounded by the slowest
+     * response instead of the sum
+     * Must be called from game thread
+     *
+     * @param pris Player Replication Info objects for the lobby
+     */
+    void LoadForAllPRIs(const std::vector<APRI_TA*>& pris);
+
     /**
      * Clears all cached avatars
      * Used when CLEAR_AVATARS_BETWEEN_MATCHES is enabled
@@ -105,15 +161,15 @@ public:
 
     /**
      * Checks if an avatar is cached for the given ID
-     * @param idString String representation of the unique ID
+     * @param id Unique network ID of the player
      * @return true if avatar is cached
      */
-    bool IsAvatarCached(const std::string& idString);
+    bool IsAvatarCached(FUniqueNetId id);
 
     /**
      * Gets a cached avatar texture
-     * @param idString String representation of the unique ID
+     * @param id Unique network ID of the player
      * @return Cached texture or nullptr if not found
      */
-    UTexture2DDynamic* GetCachedAvatar(const std::string& idString);
+    UTexture2DDynamic* GetCachedAvatar(FUniqueNetId id);
 };
\ No newline at end of file
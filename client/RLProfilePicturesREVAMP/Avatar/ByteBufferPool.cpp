@@ -0,0 +1,43 @@
+#include "pch.h"
+#include "ByteBufferPool.h"
+
+// =============================================================================
+// BYTE BUFFER POOL
+// =============================================================================
+
+ByteBufferPool& ByteBufferPool::Instance() {
+    static ByteBufferPool instance;
+    return instance;
+}
+
+std::shared_ptr<std::vector<uint8_t>> ByteBufferPool::Acquire() {
+    std::unique_ptr<std::vector<uint8_t>> buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeList.empty()) {
+            buffer = std::move(freeList.back());
+            freeList.pop_back();
+        }
+    }
+    if (!buffer) {
+        buffer = std::make_unique<std::vector<uint8_t>>();
+    }
+    buffer->clear(); // keeps capacity
+
+    return std::shared_ptr<std::vector<uint8_t>>(buffer.release(),
+        [this](std::vector<uint8_t>* released) { Release(released); });
+}
+
+void ByteBufferPool::Release(std::vector<uint8_t>* buffer) {
+    if (buffer->capacity() > MAX_POOLED_CAPACITY) {
+        delete buffer;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (freeList.size() >= MAX_POOLED_BUFFERS) {
+        delete buffer;
+        return;
+    }
+    freeList.emplace_back(buffer);
+}
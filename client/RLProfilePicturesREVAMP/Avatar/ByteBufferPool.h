@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// =============================================================================
+// BYTE BUFFER POOL
+// =============================================================================
+
+/**
+ * Free-list of byte vectors for download payloads.
+ *
+ * Every completed download used to heap-allocate a fresh vector that died
+ * right after decode. Acquired buffers keep their capacity across uses, so
+ * steady-state avatar traffic stops hitting the allocator. Buffers return
+ * to the pool automatically when the last shared_ptr reference drops.
+ */
+class ByteBufferPool {
+public:
+    /**
+     * Gets the process-wide pool instance
+     * @return Reference to the singleton
+     */
+    static ByteBufferPool& Instance();
+
+    /**
+     * Acquires an empty buffer (reused capacity when available)
+     * The buffer returns to the pool when the last reference is released
+     * @return Shared pointer to a cleared byte vector
+     */
+    std::shared_ptr<std::vector<uint8_t>> Acquire();
+
+    // Non-copyable singleton
+    ByteBufferPool(const ByteBufferPool&) = delete;
+    ByteBufferPool& operator=(const ByteBufferPool&) = delete;
+
+private:
+    ByteBufferPool() = default;
+
+    /**
+     * Returns a buffer to the free list, or frees it when the pool is full
+     * or the buffer grew unreasonably large
+     * @param buffer The buffer being released (ownership transferred)
+     */
+    void Release(std::vector<uint8_t>* buffer);
+
+    // Keep at most this many idle buffers around
+    static constexpr size_t MAX_POOLED_BUFFERS = 16;
+    // Never pool buffers above this capacity so one huge image can't pin memory
+    static constexpr size_t MAX_POOLED_CAPACITY = 1024 * 1024;
+
+    std::vector<std::unique_ptr<std::vector<uint8_t>>> freeList;
+    std::mutex mutex;
+};
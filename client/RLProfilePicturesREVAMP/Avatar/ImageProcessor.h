@@ -12,11 +12,32 @@ namespace RLProfilePicturesImageProcessor {
     /**
      * Applies brightness/gamma correction to a PNG image
      * Decompresses PNG data, applies sRGB gamma correction, and recompresses
-     * 
+     *
+     * The gamma pass runs in place on the decoded pixels, so the pipeline is
+     * one decode, one sweep, one encode. The re-encode cannot be fused away:
+     * textures are created through BakkesMod's ImageWrapper, which only
+     * accepts an image file, so there is no path that hands raw RGBA to the
+     * engine directly
+     *
      * @param pngData The input PNG data as a byte vector
+     * @param brightnessEnabled Whether gamma correction should be applied
      * @return The processed PNG data as a byte vector
      * @throws std::runtime_error if image processing fails
      */
     std::vector<uint8_t> BrightenImage(const std::vector<uint8_t>& pngData,
-        const std::shared_ptr<bool>& brightnessEnabled = nullptr);
+        bool brightnessEnabled = true);
+
+    /**
+     * Rvalue overload for callers that own their buffer. When brightness is
+     * disabled and the data is already PNG, the buffer is handed back by
+     * move instead of the image-sized copy the lvalue overload must make;
+     * every other case forwards to the overload above
+     *
+     * @param pngData The input image data (consumed)
+     * @param brightnessEnabled Whether gamma correction should be applied
+     * @return The processed PNG data as a byte vector
+     * @throws std::runtime_error if image processing fails
+     */
+    std::vector<uint8_t> BrightenImage(std::vector<uint8_t>&& pngData,
+        bool brightnessEnabled = true);
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 // =============================================================================
 // CONFIGURATION CONSTANTS
 // =============================================================================
@@ -16,7 +18,8 @@ namespace RLProfilePicturesConstants {
     constexpr auto TEMP_DIRECTORY = "C:/Temp";
     constexpr auto TEMP_AVATAR_PREFIX = "avatar_";
     constexpr auto TEMP_LOCAL_AVATAR = "brightened_local_avatar.png";
-    constexpr auto TEMP_LOCAL_PREFIX = "local_avatar_";
+    constexpr auto TEMP_CACHE_DIRECTORY = "rlpp_avatar_cache";
+    constexpr auto PATTERN_CACHE_FILE = "rlpp_pattern_cache.bin";
     
     // =============================================================================
     // API ENDPOINTS
@@ -29,6 +32,25 @@ namespace RLProfilePicturesConstants {
     constexpr auto API_PSN_RETRIEVE = "/psn/retrieve/";
     constexpr auto API_SWITCH_RETRIEVE = "/switch/retrieve/";
     constexpr auto API_XBOX_RETRIEVE = "/xbox/retrieve/";
+    constexpr auto API_BULK_RETRIEVE = "/bulk/avatars/";
+
+    // Window for coalescing avatar downloads into one bulk request (seconds)
+    constexpr float AVATAR_BATCH_WINDOW = 0.05f;
+
+    // Byte budget for the in-memory avatar LRU cache
+    constexpr size_t AVATAR_CACHE_MAX_BYTES = 64ull * 1024 * 1024;
+
+    // How long a failed/empty avatar lookup suppresses re-requests (seconds)
+    constexpr int AVATAR_NEGATIVE_CACHE_TTL = 600;
+
+    // How long an avatar persisted to disk stays valid across sessions (seconds)
+    constexpr int AVATAR_DISK_CACHE_TTL = 86400;
+
+    // How long a successful local-player CDN fetch suppresses re-fetches (seconds)
+    constexpr int LOCAL_EPIC_REFETCH_TTL = 120;
+
+    // Window within which repeat LoadForPRI triggers for the same player are dropped (ms)
+    constexpr int PRI_LOAD_DEBOUNCE_MS = 250;
     
     // =============================================================================
     // CVAR NAMES
@@ -65,8 +87,17 @@ namespace RLProfilePicturesConstants {
     // MEMORY PATTERNS
     // =============================================================================
     
-    // Pattern for GNames/GObjects
-    constexpr auto GNAMES_PATTERN = "?? ?? ?? ?? ?? ?? 00 00 ?? ?? 01 00 35 25 02 00";
+    // Pattern for GNames/GObjects, pre-parsed into byte + wildcard arrays
+    // so FindPattern does not re-tokenize a string per call
+    // (string form: "?? ?? ?? ?? ?? ?? 00 00 ?? ?? 01 00 35 25 02 00")
+    constexpr uint8_t GNAMES_BYTES[16] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0x00, 0x35, 0x25, 0x02, 0x00
+    };
+    constexpr bool GNAMES_WILDCARD[16] = {
+        true,  true,  true,  true,  true,  true,  false, false,
+        true,  true,  false, false, false, false, false, false
+    };
     constexpr auto GOBJ_OFFSET = 0x48;
     
     // =============================================================================
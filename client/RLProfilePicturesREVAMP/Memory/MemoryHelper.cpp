@@ -1,11 +1,15 @@
 #include "pch.h"
 #include "MemoryHelper.h"
 #include "../Config/Constants.h"
+#include "../Utils/FileUtils.h"
 // windows.h is included via pch.h
-#include <tlhelp32.h>
 #include <psapi.h>
 #include <iostream>
+#include <filesystem>
+#include <fstream>
 #include <vector>
+#include <cstring>
+#include <memory>
 
 // =============================================================================
 // MEMORY HELPER IMPLEMENTATION
@@ -28,6 +32,7 @@ MemoryHelper::MemoryHelper() {
         MODULEINFO modInfo;
         if (GetModuleInformation(processHandle, hMods[0], &modInfo, sizeof(modInfo))) {
             baseAddress = reinterpret_cast<uintptr_t>(modInfo.lpBaseOfDll);
+            moduleSize = modInfo.SizeOfImage;
         }
     }
 }
@@ -43,25 +48,34 @@ uintptr_t MemoryHelper::GetBaseAddress() const {
 }
 
 void MemoryHelper::GetProcess() {
-    PROCESSENTRY32 processEntry;
-    processEntry.dwSize = sizeof(PROCESSENTRY32);
-    
-    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    
-    if (Process32First(snapshot, &processEntry)) {
-        do {
-            std::wstring processNameW(processEntry.szExeFile);
-            std::string currentProcessName(processNameW.begin(), processNameW.end());
-            
-            if (currentProcessName.find(processName) != std::string::npos) {
-                processId = processEntry.th32ProcessID;
-                CloseHandle(snapshot);
+    // EnumProcesses + a per-PID image-name query: cheaper than a
+    // Toolhelp32 snapshot, which allocates a kernel-side copy of the
+    // whole process list just to find one name
+    DWORD pids[2048];
+    DWORD cbReturned = 0;
+
+    if (EnumProcesses(pids, sizeof(pids), &cbReturned)) {
+        const DWORD count = cbReturned / sizeof(DWORD);
+        for (DWORD i = 0; i < count; ++i) {
+            if (pids[i] == 0) continue;
+
+            HANDLE candidate = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pids[i]);
+            if (candidate == NULL) continue;
+
+            wchar_t imagePath[MAX_PATH];
+            DWORD pathLen = MAX_PATH;
+            const bool matched = QueryFullProcessImageNameW(candidate, 0, imagePath, &pathLen) &&
+                                 wcsstr(imagePath, processName.c_str()) != nullptr;
+            CloseHandle(candidate);
+
+            if (matched) {
+                processId = pids[i];
+                processPath = imagePath;
                 return;
             }
-        } while (Process32Next(snapshot, &processEntry));
+        }
     }
-    
-    CloseHandle(snapshot);
+
     // exit(0) is intentional
     std::cout << "Process not found." << std::endl;
     exit(0);
@@ -87,8 +101,8 @@ uintptr_t MemoryHelper::FindPattern(const std::string& pattern) {
     }
     
     std::vector<uint8_t> bytePattern(patternBytes.size());
-    std::vector<bool> wildcard(patternBytes.size());
-    
+    std::unique_ptr<bool[]> wildcard(new bool[patternBytes.size()]);
+
     for (size_t i = 0; i < patternBytes.size(); ++i) {
         if (patternBytes[i] == "??") {
             bytePattern[i] = 0x00;
@@ -99,33 +113,90 @@ uintptr_t MemoryHelper::FindPattern(const std::string& pattern) {
             wildcard[i] = false;
         }
     }
-    
-    // Search through process memory
+
+    return FindPattern(bytePattern.data(), wildcard.get(), bytePattern.size());
+}
+
+uintptr_t MemoryHelper::FindPattern(const uint8_t* bytes, const bool* wildcard, size_t length) {
+    // Anchor the scan on the first non-wildcard byte: the CRT's memchr is
+    // vectorized, so it skips straight to candidate positions and only
+    // those pay for the full pattern compare, instead of running the inner
+    // loop at every single offset of every region
+    const size_t patLen = length;
+    size_t firstFixed = 0;
+    while (firstFixed < patLen && wildcard[firstFixed]) {
+        ++firstFixed;
+    }
+
+    auto matchesAt = [&](const uint8_t* p) {
+        for (size_t j = 0; j < patLen; ++j) {
+            if (!wildcard[j] && bytes[j] != p[j]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Search through process memory in fixed-size slices through one
+    // reusable scratch buffer. Regions are often tens of MB, and a
+    // vector<uint8_t> per region both zero-fills memory that
+    // ReadProcessMemory is about to overwrite and churns the heap;
+    // consecutive slices overlap by patLen - 1 bytes so a pattern
+    // straddling a slice boundary is still found
+    constexpr size_t kSliceSize = 1 << 20;
+    // Plain new[]: make_unique would value-initialize the slice, and
+    // ReadProcessMemory overwrites it anyway
+    std::unique_ptr<uint8_t[]> scratch(new uint8_t[kSliceSize]);
+
     MEMORY_BASIC_INFORMATION mbi;
     uintptr_t currentAddress = baseAddress;
-    
-    while (VirtualQueryEx(processHandle, reinterpret_cast<LPCVOID>(currentAddress), &mbi, sizeof(mbi))) {
-        if (mbi.State == MEM_COMMIT && (mbi.Protect & PAGE_GUARD) == 0 && (mbi.Protect & PAGE_NOACCESS) == 0) {
-            std::vector<uint8_t> buffer(mbi.RegionSize);
-            SIZE_T bytesRead;
-            
-            if (ReadProcessMemory(processHandle, mbi.BaseAddress, buffer.data(), mbi.RegionSize, &bytesRead)) {
-                for (size_t i = 0; i < bytesRead - bytePattern.size(); ++i) {
-                    bool found = true;
-                    for (size_t j = 0; j < bytePattern.size(); ++j) {
-                        if (!wildcard[j] && bytePattern[j] != buffer[i + j]) {
-                            found = false;
-                            break;
-                        }
+    // The GNames pattern lives inside the main module, so the walk stops
+    // at its image end instead of querying the rest of the 128 TiB
+    // user-mode space region by region
+    const uintptr_t scanEnd = moduleSize ? baseAddress + moduleSize : UINTPTR_MAX;
+
+    while (currentAddress < scanEnd &&
+           VirtualQueryEx(processHandle, reinterpret_cast<LPCVOID>(currentAddress), &mbi, sizeof(mbi))) {
+        if (mbi.State == MEM_COMMIT && (mbi.Protect & PAGE_GUARD) == 0 && (mbi.Protect & PAGE_NOACCESS) == 0 &&
+            firstFixed < patLen) {
+            const uintptr_t regionBase = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+            size_t offset = 0;
+
+            while (offset < mbi.RegionSize) {
+                const size_t want = (mbi.RegionSize - offset < kSliceSize) ? (mbi.RegionSize - offset) : kSliceSize;
+                SIZE_T bytesRead = 0;
+                if (!ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(regionBase + offset),
+                                       scratch.get(), want, &bytesRead) ||
+                    bytesRead < patLen) {
+                    break;
+                }
+
+                const uint8_t* begin = scratch.get();
+                const uint8_t anchor = bytes[firstFixed];
+                // Last position the anchor byte can occupy and still leave
+                // room for the rest of the pattern
+                const uint8_t* anchorEnd = begin + (bytesRead - patLen) + firstFixed + 1;
+                const uint8_t* p = begin + firstFixed;
+
+                while (p < anchorEnd) {
+                    p = static_cast<const uint8_t*>(memchr(p, anchor, anchorEnd - p));
+                    if (!p) {
+                        break;
                     }
-                    
-                    if (found) {
-                        return reinterpret_cast<uintptr_t>(mbi.BaseAddress) + i;
+                    const uint8_t* start = p - firstFixed;
+                    if (matchesAt(start)) {
+                        return regionBase + offset + (start - begin);
                     }
+                    ++p;
+                }
+
+                if (bytesRead < want) {
+                    break;
                 }
+                offset += bytesRead - (patLen - 1);
             }
         }
-        
+
         currentAddress = reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize;
     }
     
@@ -134,3 +205,77 @@ uintptr_t MemoryHelper::FindPattern(const std::string& pattern) {
     exit(0);
     return 0;
 }
+
+namespace {
+    // Persisted alongside the other temp-directory caches; valid only
+    // while the executable's write time and image size both match
+    struct PatternCacheRecord {
+        int64_t  exeWriteTimeTicks = 0;
+        uint64_t imageSize = 0;
+        uint64_t offset = 0;
+    };
+
+    std::filesystem::path PatternCachePath() {
+        return RLProfilePicturesFileUtils::GetTempDirectory() /
+               RLProfilePicturesConstants::PATTERN_CACHE_FILE;
+    }
+}
+
+uintptr_t MemoryHelper::FindPatternCached(const uint8_t* bytes, const bool* wildcard, size_t length) {
+    // Identify the running executable build by its write time; a patch
+    // changes it, and so does the image size checked below
+    int64_t exeWriteTimeTicks = 0;
+    if (!processPath.empty()) {
+        std::error_code ec;
+        const auto writeTime = std::filesystem::last_write_time(processPath, ec);
+        if (!ec) {
+            exeWriteTimeTicks = writeTime.time_since_epoch().count();
+        }
+    }
+
+    auto matchesAt = [&](const uint8_t* p) {
+        for (size_t j = 0; j < length; ++j) {
+            if (!wildcard[j] && bytes[j] != p[j]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (exeWriteTimeTicks != 0 && moduleSize != 0) {
+        PatternCacheRecord rec;
+        std::ifstream in(PatternCachePath(), std::ios::binary);
+        if (in.read(reinterpret_cast<char*>(&rec), sizeof(rec)) &&
+            rec.exeWriteTimeTicks == exeWriteTimeTicks &&
+            rec.imageSize == moduleSize &&
+            rec.offset + length <= moduleSize) {
+            // Same build: re-verify the pattern at the cached offset with
+            // one small read instead of re-scanning the module
+            std::vector<uint8_t> probe(length);
+            SIZE_T bytesRead = 0;
+            if (ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(baseAddress + rec.offset),
+                                  probe.data(), length, &bytesRead) &&
+                bytesRead == length && matchesAt(probe.data())) {
+                return baseAddress + static_cast<uintptr_t>(rec.offset);
+            }
+        }
+    }
+
+    const uintptr_t address = FindPattern(bytes, wildcard, length);
+
+    if (exeWriteTimeTicks != 0 && moduleSize != 0 && address >= baseAddress) {
+        PatternCacheRecord rec;
+        rec.exeWriteTimeTicks = exeWriteTimeTicks;
+        rec.imageSize = moduleSize;
+        rec.offset = address - baseAddress;
+
+        std::error_code ec;
+        std::filesystem::create_directories(PatternCachePath().parent_path(), ec);
+        std::ofstream out(PatternCachePath(), std::ios::binary | std::ios::trunc);
+        if (out) {
+            out.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+        }
+    }
+
+    return address;
+}
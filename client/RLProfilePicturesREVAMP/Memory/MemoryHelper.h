@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 // windows.h is included via pch.h
 
 // =============================================================================
@@ -9,10 +10,15 @@
 
 class MemoryHelper {
 private:
-    std::string processName = "RocketLeague";
+    std::wstring processName = L"RocketLeague";
+    // Full image path of the matched process, for cache-validity checks
+    std::wstring processPath;
     HANDLE processHandle;
     DWORD processId;
     uintptr_t baseAddress;
+    // SizeOfImage of the main module; caps pattern scans to the module
+    // instead of walking the whole user-mode address space (0 if unknown)
+    uintptr_t moduleSize = 0;
     
     /**
      * Finds the RocketLeague process and stores its ID
@@ -60,6 +66,31 @@ public:
      * @return Address of found pattern, or calls exit(0) on failure
      */
     uintptr_t FindPattern(const std::string& pattern);
+
+    /**
+     * Pre-parsed overload: scans for a pattern already split into byte
+     * values and a wildcard flag per position (see GNAMES_BYTES /
+     * GNAMES_WILDCARD in Constants.h), skipping the per-call string
+     * tokenization
+     * @param bytes Pattern byte values (wildcard positions ignored)
+     * @param wildcard true at positions that match any byte
+     * @param length Number of pattern positions
+     * @return Address of found pattern, or calls exit(0) on failure
+     */
+    uintptr_t FindPattern(const uint8_t* bytes, const bool* wildcard, size_t length);
+
+    /**
+     * FindPattern behind a persistent offset cache. The offset found by a
+     * previous session is stored on disk together with the executable's
+     * write time and image size; while those match, the pattern is only
+     * re-verified at the cached offset instead of re-scanning the module.
+     * Falls back to a full scan (and rewrites the cache) on any mismatch
+     * @param bytes Pattern byte values (wildcard positions ignored)
+     * @param wildcard true at positions that match any byte
+     * @param length Number of pattern positions
+     * @return Address of found pattern, or calls exit(0) on failure
+     */
+    uintptr_t FindPatternCached(const uint8_t* bytes, const bool* wildcard, size_t length);
 };
 
 // Template implementations
@@ -1,12 +1,17 @@
 ﻿#include "pch.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
+#include "Utils/Crc32.h"
+// Route stb's PNG chunk CRCs through the slice-by-8 implementation; the
+// default walks one byte per step
+#define STBIW_CRC32(buffer, len) RLProfilePicturesCrc32::Compute(buffer, len)
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
 #include "RLProfilePicturesREVAMP.h"
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <future>
 #include <thread>
@@ -29,7 +34,10 @@ void RLProfilePicturesREVAMP::onLoad() {
     // Initialize memory scanning
     {
         MemoryHelper rl;
-        const uintptr_t gnamesAddress = rl.FindPattern(RLProfilePicturesConstants::GNAMES_PATTERN);
+        const uintptr_t gnamesAddress = rl.FindPatternCached(
+            RLProfilePicturesConstants::GNAMES_BYTES,
+            RLProfilePicturesConstants::GNAMES_WILDCARD,
+            sizeof(RLProfilePicturesConstants::GNAMES_BYTES));
         const uintptr_t gobjectsAddress = gnamesAddress + RLProfilePicturesConstants::GOBJ_OFFSET;
         GNames = reinterpret_cast<TArray<FNameEntry*>*>(gnamesAddress);
         GObjects = reinterpret_cast<TArray<UObject*>*>(gobjectsAddress);
@@ -63,53 +71,53 @@ void RLProfilePicturesREVAMP::InitializeModules() {
 }
 
 void RLProfilePicturesREVAMP::InitializeCVars() {
-    // Main plugin settings
-    CVarWrapper cvarEnabled = cvarManager->registerCvar(RLProfilePicturesConstants::CVAR_ENABLED, "1",
-        "Enable the RLProfilePicturesREVAMP plugin", true, true, 0, true, 1);
-    cvarEnabled.bindTo(enabled);
-    *enabled = cvarEnabled.getBoolValue();
+    // Every boolean setting registers identically and mirrors into
+    // settingsBits, so one table row per cvar and a single registration
+    // loop replaces ten copies of the same stanza
+    struct BoolCvarDef {
+        const char* name;
+        const char* desc;
+        SettingsFlag flag;
+    };
+    static constexpr BoolCvarDef kBoolCvars[] = {
+        { RLProfilePicturesConstants::CVAR_ENABLED,
+          "Enable the RLProfilePicturesREVAMP plugin",               F_ENABLED },
+        { RLProfilePicturesConstants::CVAR_STEAM_ENABLED,
+          "Enable Steam profile pictures",                           F_STEAM },
+        { RLProfilePicturesConstants::CVAR_EPIC_ENABLED,
+          "Enable Epic profile pictures",                            F_EPIC },
+        { RLProfilePicturesConstants::CVAR_XBOX_ENABLED,
+          "Enable Xbox profile pictures",                            F_XBOX },
+        { RLProfilePicturesConstants::CVAR_PSN_ENABLED,
+          "Enable PSN profile pictures",                             F_PSN },
+        { RLProfilePicturesConstants::CVAR_SWITCH_ENABLED,
+          "Enable Switch profile pictures",                          F_SWITCH },
+        { RLProfilePicturesConstants::CVAR_BRIGHTNESS_ADJUSTMENT_ENABLED,
+          "Enable brightness adjustment for avatars",                F_BRIGHTNESS },
+        { RLProfilePicturesConstants::CVAR_LOAD_DEFAULT_AVATARS,
+          "Load default avatars for players without custom avatars", F_DEFAULT_AVATARS },
+    };
+
+    for (const BoolCvarDef& def : kBoolCvars) {
+        CVarWrapper cvar = cvarManager->registerCvar(def.name, "1", def.desc, true, true, 0, true, 1);
+        SetFlag(def.flag, cvar.getBoolValue());
+        cvar.addOnValueChanged([this, flag = def.flag](std::string, CVarWrapper changed) {
+            SetFlag(flag, changed.getBoolValue());
+        });
+    }
 
+    // Debug logs stay bound to the shared_ptr the logger holds
     CVarWrapper cvarDebug = cvarManager->registerCvar(RLProfilePicturesConstants::CVAR_DEBUG_LOGS, "1",
         "Enable debug logs", true, true, 0, true, 1);
     cvarDebug.bindTo(debug_logs);
     *debug_logs = cvarDebug.getBoolValue();
 
-    // Platform settings
-    CVarWrapper cvarSteam = cvarManager->registerCvar(RLProfilePicturesConstants::CVAR_STEAM_ENABLED, "1",
-        "Enable Steam profile pictures", true, true, 0, true, 1);
-    cvarSteam.bindTo(steam_enabled);
-    *steam_enabled = cvarSteam.getBoolValue();
-
-    CVarWrapper cvarEpic = cvarManager->registerCvar(RLProfilePicturesConstants::CVAR_EPIC_ENABLED, "1",
-        "Enable Epic profile pictures", true, true, 0, true, 1);
-    cvarEpic.bindTo(epic_enabled);
-    *epic_enabled = cvarEpic.getBoolValue();
-
-    CVarWrapper cvarXbox = cvarManager->registerCvar(RLProfilePicturesConstants::CVAR_XBOX_ENABLED, "1",
-        "Enable Xbox profile pictures", true, true, 0, true, 1);
-    cvarXbox.bindTo(xbox_enabled);
-    *xbox_enabled = cvarXbox.getBoolValue();
-
-    CVarWrapper cvarPSN = cvarManager->registerCvar(RLProfilePicturesConstants::CVAR_PSN_ENABLED, "1",
-        "Enable PSN profile pictures", true, true, 0, true, 1);
-    cvarPSN.bindTo(psn_enabled);
-    *psn_enabled = cvarPSN.getBoolValue();
-
-    CVarWrapper cvarSwitch = cvarManager->registerCvar(RLProfilePicturesConstants::CVAR_SWITCH_ENABLED, "1",
-        "Enable Switch profile pictures", true, true, 0, true, 1);
-    cvarSwitch.bindTo(switch_enabled);
-    *switch_enabled = cvarSwitch.getBoolValue();
-
     // Avatar path setting
     CVarWrapper avatarCvar = cvarManager->registerCvar(RLProfilePicturesConstants::CVAR_AVATAR_PATH, 
         RLProfilePicturesConstants::DEFAULT_AVATAR_PATH,
         "Path to local avatar image", false, false, 0, false, 0, true);
     avatarCvar.bindTo(avatar_path_string);
     *avatar_path_string = avatarCvar.getStringValue();
-    *avatar_path = std::filesystem::path(*avatar_path_string);
-    avatarCvar.addOnValueChanged([this](std::string, CVarWrapper cvar) {
-        *avatar_path = std::filesystem::path(*avatar_path_string);
-    });
 
     // Register version cvar
     CVarWrapper verCvar = cvarManager->registerCvar("RLProfilePicturesREVAMP_Version", plugin_version,
@@ -119,16 +127,6 @@ void RLProfilePicturesREVAMP::InitializeCVars() {
             cvar.setValue(plugin_version);
         }
         });
-    CVarWrapper brightnessCvar = cvarManager->registerCvar(RLProfilePicturesConstants::CVAR_BRIGHTNESS_ADJUSTMENT_ENABLED, "1",
-		"Enable brightness adjustment for avatars", true, true, 0, true, 1);
-
-    brightnessCvar.bindTo(brightness_enabled);
-	*brightness_enabled = brightnessCvar.getBoolValue();
-
-    CVarWrapper loadDefaultAvatarsCvar = cvarManager->registerCvar(RLProfilePicturesConstants::CVAR_LOAD_DEFAULT_AVATARS, "1",
-		"Load default avatars for players without custom avatars", true, true, 0, true, 1);
-	loadDefaultAvatarsCvar.bindTo(default_avatars_enabled);
-	*default_avatars_enabled = loadDefaultAvatarsCvar.getBoolValue();
 }
 
 void RLProfilePicturesREVAMP::RegisterEventHooks() {
@@ -136,11 +134,15 @@ void RLProfilePicturesREVAMP::RegisterEventHooks() {
     gameWrapper->HookEventWithCaller<ActorWrapper>(
         "Function TAGame.GFxData_MainMenu_TA.OnEnteredMainMenu",
         [this](ActorWrapper caller, void* params, std::string eventName) {
-            RLProfilePicturesLogger::LogDebug("OnEnteredMainMenu triggered");
-            
-            if (!*enabled) return;
+            RLPP_LOG_DEBUG("OnEnteredMainMenu triggered");
 
-            std::string avatarPathFromCvar = cvarManager->getCvar(RLProfilePicturesConstants::CVAR_AVATAR_PATH).getStringValue();
+            RL::InvalidateObjectCache();
+
+            if (!HasFlag(F_ENABLED)) return;
+
+            // avatar_path_string is bound to the cvar, so reading it skips
+            // the cvar manager's name lookup on every menu entry
+            const std::string& avatarPathFromCvar = *avatar_path_string;
             if (avatarPathFromCvar.empty() || avatarPathFromCvar == RLProfilePicturesConstants::DEFAULT_AVATAR_PATH) {
                 RLProfilePicturesLogger::LogError("No avatar image selected from cvar! Trying from cdn");
 				LoadStartupAvatar();
@@ -148,7 +150,7 @@ void RLProfilePicturesREVAMP::RegisterEventHooks() {
             }
 
             try {
-                RLProfilePicturesLogger::LogDebug("Loading avatar from cvar: " + avatarPathFromCvar);
+                RLPP_LOG_DEBUG("Loading avatar from cvar: " + avatarPathFromCvar);
                 avatarManager->AddLocalAvatar(avatarPathFromCvar);
                 RLProfilePicturesLogger::LogSuccess("Avatar Loaded");
             }
@@ -161,7 +163,9 @@ void RLProfilePicturesREVAMP::RegisterEventHooks() {
     gameWrapper->HookEventWithCaller<ActorWrapper>(
         "Function TAGame.PRI_TA.ReplicatedEvent",
         [this](ActorWrapper caller, void* params, std::string eventName) {
-            if (!*enabled) return;
+            // One load gates plugin-off and all-platforms-off before any
+            // param walk; this hook fires for every replicated PRI var
+            if (!RemoteAvatarsActive()) return;
             
             APRI_TA* pri = reinterpret_cast<APRI_TA*>(caller.memory_address);
             if (!pri || pri->IsLocalPlayerPRI()) {
@@ -173,8 +177,11 @@ void RLProfilePicturesREVAMP::RegisterEventHooks() {
                 return;
             }
 
-            FName name = p->VarName;
-            if (name.ToString().empty() || name.ToString() != "PlayerName") {
+            // "PlayerName" resolved to its name-table entry once on first
+            // event; comparing entry IDs replaces the two ToString()
+            // allocations this check used to make per replication event
+            static const FName kPlayerName(L"PlayerName");
+            if (p->VarName != kPlayerName) {
                 return;
             }
 
@@ -185,28 +192,50 @@ void RLProfilePicturesREVAMP::RegisterEventHooks() {
     gameWrapper->HookEventWithCaller<ActorWrapper>(
         "Function TAGame.PRI_TA.UpdatePlayerAvatar",
         [this](ActorWrapper caller, void* params, std::string eventName) {
-            if (!*enabled) return;
+            if (!RemoteAvatarsActive()) return;
             
-            RLProfilePicturesLogger::LogDebug("UpdatePlayerAvatar called");
+            RLPP_LOG_DEBUG("UpdatePlayerAvatar called");
             APRI_TA* pri = reinterpret_cast<APRI_TA*>(caller.memory_address);
             if (!pri || pri->IsLocalPlayerPRI()) {
                 return;
             }
             avatarManager->LoadForPRI(pri);
         });
-        
-    //Match start/end events for cache clearing (if CLEAR_AVATARS_BETWEEN_MATCHES is enabled)
-    if (RLProfilePicturesConstants::CLEAR_AVATARS_BETWEEN_MATCHES) {
-        gameWrapper->HookEvent("Function TAGame.GameEvent_Soccar_TA.InitGame", [this](std::string eventName) {
-            RLProfilePicturesLogger::LogDebug("Match started - clearing avatar cache");
-            avatarManager->ClearCache();
+
+    // One sweep over the whole lobby once teams exist: cached avatars apply
+    // immediately, the rest share a single bulk request per platform
+    gameWrapper->HookEventWithCaller<ActorWrapper>(
+        "Function TAGame.GameEvent_Team_TA.OnAllTeamsCreated",
+        [this](ActorWrapper caller, void* params, std::string eventName) {
+            if (!RemoteAvatarsActive()) return;
+
+            AGameEvent_TA* event = reinterpret_cast<AGameEvent_TA*>(caller.memory_address);
+            if (!event) {
+                return;
+            }
+
+            std::vector<APRI_TA*> pris;
+            pris.reserve(event->PRIs.size());
+            for (int32_t i = 0; i < event->PRIs.size(); ++i) {
+                pris.push_back(event->PRIs[i]);
+            }
+            avatarManager->LoadForAllPRIs(pris);
         });
-    }
+
+    // Match start: refresh the cached RL:: object pointers and, if
+    // CLEAR_AVATARS_BETWEEN_MATCHES is enabled, clear the avatar cache
+    gameWrapper->HookEvent("Function TAGame.GameEvent_Soccar_TA.InitGame", [this](std::string eventName) {
+        RL::InvalidateObjectCache();
+        if (RLProfilePicturesConstants::CLEAR_AVATARS_BETWEEN_MATCHES) {
+            RLPP_LOG_DEBUG("Match started - clearing avatar cache");
+            avatarManager->ClearCache();
+        }
+    });
 }
 
 void RLProfilePicturesREVAMP::LoadStartupAvatar() {
     gameWrapper->Execute([this](GameWrapper* gw) {
-        if (!gw || !*enabled) return;
+        if (!gw || !HasFlag(F_ENABLED)) return;
 
         try {
             // Get local player's ID
@@ -238,92 +267,116 @@ void RLProfilePicturesREVAMP::LoadStartupAvatar() {
 }
 
 void RLProfilePicturesREVAMP::LoadEpicAvatarFromCDN(const std::string& epicId, FUniqueNetId localId) {
-    // Download the Epic avatar for local player
-    std::string url = std::string(RLProfilePicturesConstants::API_BASE_URL) + 
-                     RLProfilePicturesConstants::API_EPIC_RETRIEVE + epicId;
+    // Drop duplicate triggers: skip if a fetch is already on the wire or
+    // one succeeded within the last LOCAL_EPIC_REFETCH_TTL seconds
+    using Ticks = std::chrono::steady_clock::duration;
+    const auto nowTicks = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto lastTicks = lastEpicFetchTicks.load(std::memory_order_relaxed);
+    if (lastTicks != 0 &&
+        std::chrono::duration_cast<std::chrono::seconds>(Ticks(nowTicks - lastTicks)).count() <
+            RLProfilePicturesConstants::LOCAL_EPIC_REFETCH_TTL) {
+        RLPP_LOG_DEBUG("Skipping Epic CDN fetch: avatar fetched recently");
+        return;
+    }
+    if (epicFetchInFlight.exchange(true)) {
+        RLPP_LOG_DEBUG("Skipping Epic CDN fetch: request already in flight");
+        return;
+    }
 
-    CurlRequest req;
-    req.url = url;
-    req.verb = "GET";
+    // Past the two atomic guards everything is file and network work, so
+    // it all runs on a worker (the AddLocalAvatar pipeline does the same);
+    // the caller's game-thread Execute body stays a handful of loads
+    std::thread([this, epicId, localId] {
+        // Serve from the persistent disk cache first: a fresh entry skips
+        // the HTTPS round-trip entirely. The raw downloaded bytes are
+        // cached (matching the remote-player disk tier), so brightness is
+        // re-applied here and always follows the current setting
+        const uint64_t cacheKey = AvatarCache::HashId(localId);
+        if (auto cached = AvatarCache::LoadFromDisk(cacheKey)) {
+            RLPP_LOG_DEBUG("Local Epic avatar served from disk cache");
+            epicFetchInFlight.store(false, std::memory_order_relaxed);
+            lastEpicFetchTicks.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                     std::memory_order_relaxed);
 
-    HttpWrapper::SendCurlRequest(req, [this, localId, epicId](int http_code, char* data_ptr, size_t data_size) {
-        if (http_code != 200) {
-            RLProfilePicturesLogger::LogError("Failed to fetch Epic avatar for local player. HTTP code: " + std::to_string(http_code));
-            LoadLocalAvatarFallback();
+            try {
+                std::vector<uint8_t> brightenedData =
+                    RLProfilePicturesImageProcessor::BrightenImage(*cached, HasFlag(F_BRIGHTNESS));
+                gameWrapper->Execute([this, localId, brightenedData = std::move(brightenedData)](GameWrapper* gw) {
+                    if (!gw) return;
+                    avatarManager->LoadAvatarDirect(localId, brightenedData, true);
+                });
+            }
+            catch (const std::exception& e) {
+                RLProfilePicturesLogger::LogError("Exception processing disk-cached Epic avatar: " + std::string(e.what()));
+            }
             return;
         }
 
-        if (data_ptr == nullptr || data_size == 0) {
-            RLProfilePicturesLogger::LogError("No Epic avatar data received for local player");
-            LoadLocalAvatarFallback();
-            return;
-        }
+        // Download the Epic avatar for local player. One sized allocation
+        // instead of the chained operator+ temporaries
+        constexpr std::string_view urlBase = RLProfilePicturesConstants::API_BASE_URL;
+        constexpr std::string_view urlEndpoint = RLProfilePicturesConstants::API_EPIC_RETRIEVE;
+        std::string url;
+        url.reserve(urlBase.size() + urlEndpoint.size() + epicId.size());
+        url.append(urlBase).append(urlEndpoint).append(epicId);
 
-        std::vector<uint8_t> data(data_ptr, data_ptr + data_size);
+        CurlRequest req;
+        req.url = url;
+        req.verb = "GET";
 
-        gameWrapper->Execute([this, localId, data, epicId](GameWrapper* gw) {
-            RLProfilePicturesLogger::LogSuccess("Epic avatar downloaded for local player: " + epicId);
+        HttpWrapper::SendCurlRequest(req, [this, localId, epicId](int http_code, char* data_ptr, size_t data_size) {
+            // The request has left the wire regardless of outcome
+            epicFetchInFlight.store(false, std::memory_order_relaxed);
 
-            try {
-                // Apply brightness adjustment and load as local avatar
-                std::vector<uint8_t> brightenedData = RLProfilePicturesImageProcessor::BrightenImage(data, brightness_enabled);
-
-                // Create temporary file
-                std::filesystem::path filePath = RLProfilePicturesFileUtils::GetTempLocalAvatarPath(epicId);
-
-                {
-                    std::ofstream out(filePath, std::ios::binary);
-                    if (out) {
-                        out.write(reinterpret_cast<const char*>(brightenedData.data()), brightenedData.size());
-                        out.flush();
-                    }
-                }
+            if (http_code != 200) {
+                RLProfilePicturesLogger::LogError("Failed to fetch Epic avatar for local player. HTTP code: " + std::to_string(http_code));
+                LoadLocalAvatarFallback();
+                return;
+            }
 
-                // Load the image and apply it as local avatar
-                auto img = std::make_unique<ImageWrapper>(filePath, true, false);
-                if (img->LoadForCanvas()) {
-                    UTexture2D* newTexture = static_cast<UTexture2D*>(img->GetCanvasTex());
-                    if (newTexture) {
-                        // Apply to local player 
-                        UVanitySetManager_TA* vman = RL::GetVanitySetManager();
-                        APlayerControllerBase_TA* pc = RL::GetPlayerController();
-
-                        if (pc && vman) {
-                            UPlayerAvatar_TA* avatar = vman->GetAvatar(localId);
-                            if (avatar) {
-                                pc->PlayerAvatar = avatar;
-                                avatar->HandleUpdateTexture(newTexture);
-                                vman->HandleLoadedAvatarAsset(avatar);
-
-                                UGFxShell_X* shell = RL::GetShell();
-                                if (shell) {
-                                    UGFxData_PlayerAvatar_TA* avatarData = UGFxData_PlayerAvatar_TA::GetOrCreate(shell, avatar);
-                                    UGFxDataStore_X* dataStore = shell->DataStore;
-                                    if (dataStore && avatarData) {
-                                        dataStore->SetTextureValue(avatarData->TableName, avatarData->RowIndex, L"ToPlayer", newTexture);
-                                    }
-                                }
-
-                                RLProfilePicturesLogger::LogSuccess("Brightened local Epic avatar applied successfully!");
-                            }
-                        }
-                    }
-                }
+            if (data_ptr == nullptr || data_size == 0) {
+                RLProfilePicturesLogger::LogError("No Epic avatar data received for local player");
+                LoadLocalAvatarFallback();
+                return;
+            }
 
-                // Clean up temporary file
-                std::filesystem::remove(filePath);
+            // Brighten on the HTTP worker thread so the game thread only pays
+            // for texture creation and the apply. The download bytes land in a
+            // pooled buffer that keeps its capacity for the next fetch
+            std::vector<uint8_t> brightenedData;
+            try {
+                auto data = ByteBufferPool::Instance().Acquire();
+                data->assign(data_ptr, data_ptr + data_size);
+                // Persist the raw bytes so the next launch skips the network
+                AvatarCache::StoreToDisk(AvatarCache::HashId(localId), *data);
+                // Moved in: with brightness off the PNG passes through
+                // without an image-sized copy
+                brightenedData = RLProfilePicturesImageProcessor::BrightenImage(std::move(*data), HasFlag(F_BRIGHTNESS));
             }
             catch (const std::exception& e) {
                 RLProfilePicturesLogger::LogError("Exception in Epic avatar brightness processing: " + std::string(e.what()));
-                std::filesystem::path filePath = RLProfilePicturesFileUtils::GetTempLocalAvatarPath(epicId);
-                std::filesystem::remove(filePath);
+                LoadLocalAvatarFallback();
+                return;
             }
+
+            lastEpicFetchTicks.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                     std::memory_order_relaxed);
+
+            gameWrapper->Execute([this, localId, epicId, brightenedData = std::move(brightenedData)](GameWrapper* gw) {
+                if (!gw) return;
+                RLProfilePicturesLogger::LogSuccess("Epic avatar downloaded for local player: " + epicId);
+
+                // The shared texture path: one unflushed temp-file write for
+                // ImageWrapper (which has no memory loader), async cleanup,
+                // then the local-player apply via SetAvatar
+                avatarManager->LoadAvatarDirect(localId, brightenedData, true);
+            });
         });
-    });
+    }).detach();
 }
 
 void RLProfilePicturesREVAMP::LoadLocalAvatarFallback() {
-    std::string avatarPathFromCvar = cvarManager->getCvar(RLProfilePicturesConstants::CVAR_AVATAR_PATH).getStringValue();
+    const std::string& avatarPathFromCvar = *avatar_path_string;
 
     if (avatarPathFromCvar.empty() || avatarPathFromCvar == RLProfilePicturesConstants::DEFAULT_AVATAR_PATH) {
         RLProfilePicturesLogger::LogInfo("No local avatar file selected, skipping avatar load");
@@ -340,6 +393,7 @@ void RLProfilePicturesREVAMP::LoadLocalAvatarFallback() {
 }
 
 void RLProfilePicturesREVAMP::RenderSettings() {
-    settingsUI->RenderSettings(enabled, debug_logs, steam_enabled, epic_enabled, 
-                              xbox_enabled, psn_enabled, switch_enabled, avatar_path, brightness_enabled, default_avatars_enabled);
+    settingsUI->RenderSettings(HasFlag(F_ENABLED), *debug_logs, HasFlag(F_STEAM), HasFlag(F_EPIC),
+                              HasFlag(F_XBOX), HasFlag(F_PSN), HasFlag(F_SWITCH),
+                              HasFlag(F_BRIGHTNESS), HasFlag(F_DEFAULT_AVATARS));
 }
\ No newline at end of file
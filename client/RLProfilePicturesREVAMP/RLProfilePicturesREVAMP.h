@@ -6,6 +6,9 @@
 #include "bakkesmod/plugin/PluginSettingsWindow.h"
 #include "RLSDK/SdkHeaders.hpp"
 #include "version.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 
 // Forward declarations
 class AvatarManager;
@@ -35,21 +38,54 @@ private:
     // CONFIGURATION VARIABLES
     // =============================================================================
 
-    // Main plugin settings
-    std::shared_ptr<bool> enabled = std::make_shared<bool>(true);
-    std::shared_ptr<bool> debug_logs = std::make_shared<bool>(true);
-    std::shared_ptr<std::string> avatar_path_string = std::make_shared<std::string>();
-    std::shared_ptr<std::filesystem::path> avatar_path = std::make_shared<std::filesystem::path>();
+    // Boolean settings packed into one atomic word. Each CVar seeds its
+    // bit at registration and keeps it in sync via addOnValueChanged, so
+    // hook callbacks test a flag with a single relaxed load instead of
+    // dereferencing a heap-allocated shared_ptr<bool> per setting
+    enum SettingsFlag : uint16_t {
+        F_ENABLED         = 1 << 0,
+        F_STEAM           = 1 << 1,
+        F_EPIC            = 1 << 2,
+        F_XBOX            = 1 << 3,
+        F_PSN             = 1 << 4,
+        F_SWITCH          = 1 << 5,
+        F_BRIGHTNESS      = 1 << 6,
+        F_DEFAULT_AVATARS = 1 << 7,
+    };
+    std::atomic<uint16_t> settingsBits{ 0 };
+
+    // All platform toggles in one mask, for hooks that are pointless when
+    // every platform is disabled
+    static constexpr uint16_t PLATFORM_FLAGS = F_STEAM | F_EPIC | F_XBOX | F_PSN | F_SWITCH;
 
-    // Platform-specific settings
-    std::shared_ptr<bool> steam_enabled = std::make_shared<bool>(true);
-    std::shared_ptr<bool> epic_enabled = std::make_shared<bool>(true);
-    std::shared_ptr<bool> xbox_enabled = std::make_shared<bool>(true);
-    std::shared_ptr<bool> psn_enabled = std::make_shared<bool>(true);
-    std::shared_ptr<bool> switch_enabled = std::make_shared<bool>(true);
-	std::shared_ptr<bool> brightness_enabled = std::make_shared<bool>(true);
+    bool HasFlag(SettingsFlag flag) const noexcept {
+        return (settingsBits.load(std::memory_order_relaxed) & flag) != 0;
+    }
+    // Single load answering "is the plugin on and at least one platform
+    // enabled" — the first-line gate of the replication hooks
+    bool RemoteAvatarsActive() const noexcept {
+        const uint16_t bits = settingsBits.load(std::memory_order_relaxed);
+        return (bits & F_ENABLED) != 0 && (bits & PLATFORM_FLAGS) != 0;
+    }
+    void SetFlag(SettingsFlag flag, bool on) noexcept {
+        if (on) {
+            settingsBits.fetch_or(static_cast<uint16_t>(flag), std::memory_order_relaxed);
+        }
+        else {
+            settingsBits.fetch_and(static_cast<uint16_t>(~flag), std::memory_order_relaxed);
+        }
+    }
 
-	std::shared_ptr<bool> default_avatars_enabled = std::make_shared<bool>(false);
+    // Guards the local-player CDN fetch: menu re-entries retrigger
+    // LoadStartupAvatar, and without this every one sends another HTTPS
+    // GET and brightness pass for the same avatar. One flag suffices
+    // since the path only ever fetches the local player
+    std::atomic<bool> epicFetchInFlight{ false };
+    std::atomic<std::chrono::steady_clock::rep> lastEpicFetchTicks{ 0 };
+
+    // Kept as a shared_ptr: the logger binds to it for its lifetime
+    std::shared_ptr<bool> debug_logs = std::make_shared<bool>(true);
+    std::shared_ptr<std::string> avatar_path_string = std::make_shared<std::string>();
     // =============================================================================
     // INITIALIZATION FUNCTIONS
     // =============================================================================
@@ -1,71 +1,123 @@
 #include "pch.h"
 #include "RLObjects.h"
 #include "RLSDK/GameDefines.hpp"
+#include <atomic>
+#include <cstdint>
 
 // =============================================================================
-// ROCKET LEAGUE OBJECT GETTERS 
+// ROCKET LEAGUE OBJECT GETTERS
 // =============================================================================
 
 namespace RL {
-    
+
+    namespace {
+        // Generation counter for the cached pointers below. Match init and
+        // menu entry bump it, so a pointer resolved in the previous map is
+        // never handed out again; a null result is re-resolved on the next
+        // call rather than cached, since the objects may simply not exist
+        // yet during loading. Atomic because the getters also run on HTTP
+        // callback threads while the game thread bumps it; each getter
+        // loads it once so the compared and stored generations agree
+        std::atomic<uint32_t> g_cacheGen{ 1 };
+
+        struct Cached {
+            uint32_t gen = 0;
+            void* ptr = nullptr;
+        };
+    }
+
+    void InvalidateObjectCache() {
+        g_cacheGen.fetch_add(1, std::memory_order_relaxed);
+    }
+
     UGameEngine_TA* GetRLGameEngine() {
-        return reinterpret_cast<UGameEngine_TA*>(UEngine::GetEngine());
+        static thread_local Cached c;
+        const uint32_t gen = g_cacheGen.load(std::memory_order_relaxed);
+        if (c.gen == gen && c.ptr) {
+            return static_cast<UGameEngine_TA*>(c.ptr);
+        }
+        UGameEngine_TA* engine = reinterpret_cast<UGameEngine_TA*>(UEngine::GetEngine());
+        c = { gen, engine };
+        return engine;
     }
-    
+
     ULocalPlayer_TA* GetLocalPlayer(int index) {
         UGameEngine_TA* engine = GetRLGameEngine();
         if (!engine || engine->GamePlayers.size() <= index) return nullptr;
         return reinterpret_cast<ULocalPlayer_TA*>(engine->GamePlayers[index]);
     }
-    
+
     APlayerControllerBase_TA* GetPlayerController(int index) {
+        static thread_local Cached c;
+        const uint32_t gen = g_cacheGen.load(std::memory_order_relaxed);
+        if (index == 0 && c.gen == gen && c.ptr) {
+            return static_cast<APlayerControllerBase_TA*>(c.ptr);
+        }
         ULocalPlayer_TA* lp = GetLocalPlayer(index);
-        if (!lp) return nullptr;
-        return reinterpret_cast<APlayerControllerBase_TA*>(lp->Actor);
+        APlayerControllerBase_TA* pc = lp ? reinterpret_cast<APlayerControllerBase_TA*>(lp->Actor) : nullptr;
+        if (index == 0) {
+            c = { gen, pc };
+        }
+        return pc;
     }
-    
+
     AHUDBase_TA* GetHUD(int index) {
         APlayerControllerBase_TA* pc = GetPlayerController(index);
         if (!pc) return nullptr;
         return reinterpret_cast<AHUDBase_TA*>(pc->myHUD);
     }
-    
+
     UGFxShell_TA* GetShell(int index) {
         AHUDBase_TA* hud = GetHUD(index);
         if (!hud) return nullptr;
         return reinterpret_cast<UGFxShell_TA*>(hud->Shell);
     }
-    
+
     UEngineShare_TA* GetEngineShare() {
         UGameEngine_TA* engine = GetRLGameEngine();
         if (!engine) return nullptr;
         return reinterpret_cast<UEngineShare_TA*>(engine->EngineShare);
     }
-    
+
     UVanitySetManager_TA* GetVanitySetManager() {
-        static UVanitySetManager_TA* vanityManager = nullptr;
-        if (!vanityManager || !vanityManager->IsValid() || !vanityManager->IsA<UVanitySetManager_TA>()) {
-            APlayerControllerBase_TA* pc = GetPlayerController();
-            if (pc)
-                vanityManager = pc->VanityMgr;
+        // Generation-checked like the getters above instead of probing the
+        // stale pointer with IsValid()/IsA<>() on every call. The cache is
+        // additionally keyed on the controller it was resolved through, so
+        // a mid-generation controller swap re-resolves immediately
+        static thread_local Cached c;
+        static thread_local APlayerControllerBase_TA* cachedPc = nullptr;
+        const uint32_t gen = g_cacheGen.load(std::memory_order_relaxed);
+        APlayerControllerBase_TA* pc = GetPlayerController();
+        if (pc == cachedPc && c.gen == gen && c.ptr) {
+            return static_cast<UVanitySetManager_TA*>(c.ptr);
         }
+        UVanitySetManager_TA* vanityManager = pc ? pc->VanityMgr : nullptr;
+        cachedPc = pc;
+        c = { gen, vanityManager };
         return vanityManager;
     }
 
-    
+
     FUniqueNetId* GetPrimaryPlayerID() {
+        static thread_local Cached c;
+        const uint32_t gen = g_cacheGen.load(std::memory_order_relaxed);
+        if (c.gen == gen && c.ptr) {
+            return static_cast<FUniqueNetId*>(c.ptr);
+        }
+
         UGameEngine_TA* engine = GetRLGameEngine();
         if (!engine) return nullptr;
-        
+
         UEngineShare_TA* share = reinterpret_cast<UEngineShare_TA*>(engine->EngineShare);
         if (!share) return nullptr;
-        
+
         UOnlineGame_TA* onlineGame = reinterpret_cast<UOnlineGame_TA*>(share->OnlineGame);
         if (!onlineGame || onlineGame->OnlinePlayers.size() == 0) return nullptr;
-        
+
         UOnlinePlayer_X* player = onlineGame->OnlinePlayers[0];
         if (!player) return nullptr;
-        
+
+        c = { gen, &player->PlayerID };
         return &player->PlayerID;
     }
 }
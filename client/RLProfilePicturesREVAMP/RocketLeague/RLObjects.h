@@ -7,7 +7,14 @@
 // =============================================================================
 
 namespace RL {
-    
+
+    /**
+     * Invalidates the cached object pointers returned by the getters below.
+     * Called on match init and main-menu entry so the getters never hand
+     * out a pointer resolved in the previous map
+     */
+    void InvalidateObjectCache();
+
     /**
      * Gets the main Rocket League game engine instance
      * @return Pointer to UGameEngine_TA or nullptr if not available
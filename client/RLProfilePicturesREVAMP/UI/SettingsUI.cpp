@@ -12,22 +12,31 @@ constexpr auto pretty_plugin_version = "v" stringify(VERSION_MAJOR) "." stringif
 // SETTINGS UI IMPLEMENTATION
 // =============================================================================
 
-// Static UI state
-float SettingsUI::feedbackTime = 0.0f;
-std::string SettingsUI::feedbackMessage = "";
+extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
 
-SettingsUI::SettingsUI(std::shared_ptr<GameWrapper> gw, std::shared_ptr<AvatarManager> avatarMgr) 
-    : gameWrapper(gw), avatarManager(avatarMgr) {}
+SettingsUI::SettingsUI(std::shared_ptr<GameWrapper> gw, std::shared_ptr<AvatarManager> avatarMgr)
+    : gameWrapper(gw), avatarManager(avatarMgr), cvarManager(_globalCvarManager.get()) {}
 
-void SettingsUI::RenderOption(const char* label, const char* cvarName, 
-                             std::shared_ptr<bool> value, const float color[4], const char* tooltip) {
-    extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
-    
-    ImGui::TextColored(ImVec4(color[0], color[1], color[2], color[3]), label);
+SettingsUI::~SettingsUI() {
+    delete pendingFeedback.exchange(nullptr);
+}
+
+void SettingsUI::RenderOption(const char* label, const char* cvarName,
+                             bool value, const float color[4], const char* tooltip) {
+    // Style-color push + unformatted text: the color rides in the vertex
+    // buffer without a draw-command split, and the label skips the
+    // printf-style format pass TextColored would run it through
+    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(color[0], color[1], color[2], color[3]));
+    ImGui::TextUnformatted(label);
+    ImGui::PopStyleColor();
     ImGui::NextColumn();
-    if (ImGui::Checkbox(("##" + std::string(label)).c_str(), value.get())) {
-        if (_globalCvarManager) {
-            _globalCvarManager->getCvar(cvarName).setValue(*value);
+    // ID formatted on the stack: this runs every frame, and the string
+    // concatenation it replaces was a per-frame heap allocation
+    char id[128];
+    std::snprintf(id, sizeof(id), "##%s", label);
+    if (ImGui::Checkbox(id, &value)) {
+        if (cvarManager) {
+            cvarManager->getCvar(cvarName).setValue(value);
         }
     }
     if (ImGui::IsItemHovered(65536)) {
@@ -37,18 +46,20 @@ void SettingsUI::RenderOption(const char* label, const char* cvarName,
 }
 
 void SettingsUI::RenderPlatformOption(const char* prefix, const char* platform, const char* suffix,
-                                     const char* cvarName, std::shared_ptr<bool> value, const float color[4], const char* tooltip) {
-    extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
-    
+                                     const char* cvarName, bool value, const float color[4], const char* tooltip) {
     ImGui::TextUnformatted(prefix);
     ImGui::SameLine(0.0f, 0.0f);
-    ImGui::TextColored(ImVec4(color[0], color[1], color[2], color[3]), "%s", platform);
+    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(color[0], color[1], color[2], color[3]));
+    ImGui::TextUnformatted(platform);
+    ImGui::PopStyleColor();
     ImGui::SameLine(0.0f, 0.0f);
     ImGui::TextUnformatted(suffix);
     ImGui::NextColumn();
-    if (ImGui::Checkbox(("##" + std::string(prefix) + platform + suffix).c_str(), value.get())) {
-        if (_globalCvarManager) {
-            _globalCvarManager->getCvar(cvarName).setValue(*value);
+    char id[128];
+    std::snprintf(id, sizeof(id), "##%s%s%s", prefix, platform, suffix);
+    if (ImGui::Checkbox(id, &value)) {
+        if (cvarManager) {
+            cvarManager->getCvar(cvarName).setValue(value);
         }
     }
     if (ImGui::IsItemHovered(65536)) {
@@ -57,28 +68,24 @@ void SettingsUI::RenderPlatformOption(const char* prefix, const char* platform,
     ImGui::NextColumn();
 }
 
-void SettingsUI::RenderSettings(std::shared_ptr<bool> enabled,
-                               std::shared_ptr<bool> debug_logs,
-                               std::shared_ptr<bool> steam_enabled,
-                               std::shared_ptr<bool> epic_enabled,
-                               std::shared_ptr<bool> xbox_enabled,
-                               std::shared_ptr<bool> psn_enabled,
-                               std::shared_ptr<bool> switch_enabled,
-                               std::shared_ptr<std::filesystem::path> avatar_path,
-                               std::shared_ptr<bool> brightness_enabled,
-                               std::shared_ptr<bool> default_avatars_enabled) {
-    extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
-    
+void SettingsUI::RenderSettings(bool enabled,
+                               bool debug_logs,
+                               bool steam_enabled,
+                               bool epic_enabled,
+                               bool xbox_enabled,
+                               bool psn_enabled,
+                               bool switch_enabled,
+                               bool brightness_enabled,
+                               bool default_avatars_enabled) {
     // Header section
     if (ImGui::BeginChild("Header", ImVec2(0, RLProfilePicturesConstants::HEADER_HEIGHT), true)) {
-        // Add some spacing
-        for (int i = 0; i < 4; i++) {
-            ImGui::Spacing();
-        }
-        ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Plugin made by borgox (@borghetoo on dc)");
-        for (int i = 0; i < 5; i++) {
-            ImGui::Spacing();
-        }
+        // One dummy item per gap instead of a Spacing() per line: each
+        // Spacing() submits its own item into the draw list
+        ImGui::Dummy(ImVec2(0, 4 * ImGui::GetStyle().ItemSpacing.y));
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
+        ImGui::TextUnformatted("Plugin made by borgox (@borghetoo on dc)");
+        ImGui::PopStyleColor();
+        ImGui::Dummy(ImVec2(0, 5 * ImGui::GetStyle().ItemSpacing.y));
         ImGui::Text(pretty_plugin_version);
     }
     ImGui::EndChild();
@@ -149,9 +156,8 @@ void SettingsUI::RenderSettings(std::shared_ptr<bool> enabled,
         if (ImGui::Button("Select Avatar Image (.png, .jpg, .jpeg)")) {
             std::filesystem::path imagePath;
             if (RLProfilePicturesFileUtils::OpenImageFileDialog(imagePath)) {
-                *avatar_path = imagePath;
-                if (_globalCvarManager) {
-                    _globalCvarManager->getCvar(RLProfilePicturesConstants::CVAR_AVATAR_PATH).setValue(RLProfilePicturesFileUtils::WStringToUtf8(imagePath.c_str()));
+                if (cvarManager) {
+                    cvarManager->getCvar(RLProfilePicturesConstants::CVAR_AVATAR_PATH).setValue(RLProfilePicturesFileUtils::WStringToUtf8(imagePath.c_str()));
                 }
                 
                 gameWrapper->Execute([this, imagePath](GameWrapper* gw) {
@@ -183,21 +189,30 @@ void SettingsUI::RenderSettings(std::shared_ptr<bool> enabled,
         }
         
         // Add some spacing
-        for (int i = 0; i < 2; i++) {
-            ImGui::Spacing();
-        }
+        ImGui::Dummy(ImVec2(0, 2 * ImGui::GetStyle().ItemSpacing.y));
         
-        // Display feedback message
-        if (!feedbackMessage.empty() && 
-            ImGui::GetTime() - feedbackTime < RLProfilePicturesConstants::FEEDBACK_DURATION) {
+        // Adopt a message posted from the game thread, if any — the slot
+        // exchange is the only cross-thread touch; display state below is
+        // render-thread-only
+        if (std::string* pending = pendingFeedback.exchange(nullptr, std::memory_order_acquire)) {
+            feedbackMessage = std::move(*pending);
+            delete pending;
+            feedbackExpiresAt = ImGui::GetTime() + RLProfilePicturesConstants::FEEDBACK_DURATION;
+        }
+
+        // Display feedback message until its precomputed expiry; the
+        // string is cleared once on the first frame past it rather than
+        // reassigned every frame
+        if (ImGui::GetTime() < feedbackExpiresAt) {
             ImGui::TextColored(ImVec4(RLProfilePicturesConstants::COLOR_SUCCESS[0],
                                      RLProfilePicturesConstants::COLOR_SUCCESS[1],
                                      RLProfilePicturesConstants::COLOR_SUCCESS[2],
-                                     RLProfilePicturesConstants::COLOR_SUCCESS[3]), 
+                                     RLProfilePicturesConstants::COLOR_SUCCESS[3]),
                               "%s", feedbackMessage.c_str());
         }
-        else if (ImGui::GetTime() - feedbackTime >= RLProfilePicturesConstants::FEEDBACK_DURATION) {
-            feedbackMessage = "";
+        else if (!feedbackMessage.empty()) {
+            feedbackMessage.clear();
+            feedbackMessage.shrink_to_fit();
         }
     }
     ImGui::EndChild();
@@ -209,6 +224,8 @@ void SettingsUI::RenderSettings(std::shared_ptr<bool> enabled,
 }
 
 void SettingsUI::SetFeedback(const std::string& message) {
-    feedbackMessage = message;
-    feedbackTime = ImGui::GetTime();
+    // Most-recent-wins: a message still waiting in the slot is replaced
+    // and freed by whichever side exchanges it out
+    auto* incoming = new std::string(message);
+    delete pendingFeedback.exchange(incoming, std::memory_order_release);
 }
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <memory>
 
 // Forward declarations
 class GameWrapper;
 class AvatarManager;
+class CVarManagerWrapper;
 
 // =============================================================================
 // SETTINGS UI 
@@ -15,22 +17,33 @@ class SettingsUI {
 private:
     std::shared_ptr<GameWrapper> gameWrapper;
     std::shared_ptr<AvatarManager> avatarManager;
+    // Raw pointer cached once at construction: the global manager outlives
+    // the plugin, and going through it directly skips the shared_ptr
+    // control-block read every checkbox interaction paid
+    CVarManagerWrapper* cvarManager = nullptr;
     
-    // UI state
-    static float feedbackTime;
-    static std::string feedbackMessage;
+    // Feedback state. SetFeedback is called from lambdas on the game
+    // thread while rendering happens on the render thread, so the
+    // hand-off goes through a single atomic slot: producers exchange a
+    // heap string in, the render pass adopts it. Display string and
+    // expiry are then touched by the render thread only
+    std::atomic<std::string*> pendingFeedback{ nullptr };
+    double feedbackExpiresAt = 0.0;
+    std::string feedbackMessage;
     
     /**
      * Renders a platform-specific checkbox option
+     * The checkbox edits a local copy of the value; toggling writes the
+     * CVar, whose change callback updates the plugin's settings bits
      */
     void RenderPlatformOption(const char* prefix, const char* platform, const char* suffix,
-                             const char* cvarName, std::shared_ptr<bool> value, const float color[4], const char* tooltip);
-    
+                             const char* cvarName, bool value, const float color[4], const char* tooltip);
+
     /**
      * Renders a standard checkbox option
      */
-    void RenderOption(const char* label, const char* cvarName, 
-                     std::shared_ptr<bool> value, const float color[4], const char* tooltip);
+    void RenderOption(const char* label, const char* cvarName,
+                     bool value, const float color[4], const char* tooltip);
 
 public:
     /**
@@ -39,7 +52,8 @@ public:
      * @param avatarMgr AvatarManager instance
      */
     SettingsUI(std::shared_ptr<GameWrapper> gw, std::shared_ptr<AvatarManager> avatarMgr);
-    
+    ~SettingsUI();
+
     /**
      * Renders the complete settings window
      * @param enabled Plugin enabled state
@@ -49,20 +63,18 @@ public:
      * @param xbox_enabled Xbox platform enabled state
      * @param psn_enabled PSN platform enabled state
      * @param switch_enabled Switch platform enabled state
-     * @param avatar_path Current avatar path
 	 * @param brightness_enabled Brightness adjustment enabled state
 	 * @param default_avatars_enabled Default avatars enabled state
      */
-    void RenderSettings(std::shared_ptr<bool> enabled,
-                       std::shared_ptr<bool> debug_logs,
-                       std::shared_ptr<bool> steam_enabled,
-                       std::shared_ptr<bool> epic_enabled,
-                       std::shared_ptr<bool> xbox_enabled,
-                       std::shared_ptr<bool> psn_enabled,
-                       std::shared_ptr<bool> switch_enabled,
-                       std::shared_ptr<std::filesystem::path> avatar_path,
-                       std::shared_ptr<bool> brightness_enabled,
-                       std::shared_ptr<bool> default_avatars_enabled);
+    void RenderSettings(bool enabled,
+                       bool debug_logs,
+                       bool steam_enabled,
+                       bool epic_enabled,
+                       bool xbox_enabled,
+                       bool psn_enabled,
+                       bool switch_enabled,
+                       bool brightness_enabled,
+                       bool default_avatars_enabled);
     
     /**
      * Sets feedback message for UI display
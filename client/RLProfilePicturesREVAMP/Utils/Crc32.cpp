@@ -0,0 +1,60 @@
+#include "pch.h"
+#include "Crc32.h"
+#include <cstring>
+
+// =============================================================================
+// CRC32 IMPLEMENTATION
+// =============================================================================
+
+namespace {
+    // Eight derived tables so each step folds 8 bytes at once. Built during
+    // static init (same pattern as the gamma tables in ImageProcessor), so
+    // there is no first-call race
+    struct Crc32Tables {
+        uint32_t t[8][256];
+        Crc32Tables() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0u);
+                }
+                t[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (int slice = 1; slice < 8; ++slice) {
+                    t[slice][i] = (t[slice - 1][i] >> 8) ^ t[0][t[slice - 1][i] & 0xFF];
+                }
+            }
+        }
+    };
+    const Crc32Tables g_tables;
+}
+
+namespace RLProfilePicturesCrc32 {
+
+    uint32_t Compute(const unsigned char* buffer, int len) {
+        uint32_t crc = 0xFFFFFFFFu;
+        size_t remaining = len > 0 ? static_cast<size_t>(len) : 0;
+
+        while (remaining >= 8) {
+            uint32_t lo, hi;
+            std::memcpy(&lo, buffer, 4);
+            std::memcpy(&hi, buffer + 4, 4);
+            lo ^= crc;
+            crc = g_tables.t[7][lo & 0xFF] ^
+                  g_tables.t[6][(lo >> 8) & 0xFF] ^
+                  g_tables.t[5][(lo >> 16) & 0xFF] ^
+                  g_tables.t[4][lo >> 24] ^
+                  g_tables.t[3][hi & 0xFF] ^
+                  g_tables.t[2][(hi >> 8) & 0xFF] ^
+                  g_tables.t[1][(hi >> 16) & 0xFF] ^
+                  g_tables.t[0][hi >> 24];
+            buffer += 8;
+            remaining -= 8;
+        }
+        while (remaining--) {
+            crc = (crc >> 8) ^ g_tables.t[0][(crc ^ *buffer++) & 0xFF];
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+}
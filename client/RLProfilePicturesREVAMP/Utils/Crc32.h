@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+// =============================================================================
+// CRC32 (zlib polynomial)
+// =============================================================================
+
+namespace RLProfilePicturesCrc32 {
+
+    /**
+     * Computes the CRC32 used by PNG/zlib (polynomial 0xEDB88320) with a
+     * slice-by-8 table walk, processing 8 input bytes per step instead of
+     * the 1 byte/step of the classic single-table loop. Plugged into stb's
+     * PNG writer via the STBIW_CRC32 hook
+     * @param buffer The bytes to checksum
+     * @param len Number of bytes
+     * @return The CRC32 value
+     */
+    uint32_t Compute(const unsigned char* buffer, int len);
+}
@@ -2,8 +2,11 @@
 #include "FileUtils.h"
 #include "../Config/Constants.h"
 // windows.h is included via pch.h
-#include <commdlg.h>
+#include <shobjidl.h>
+#include <atomic>
 #include <filesystem>
+#include <mutex>
+#include <thread>
 
 // =============================================================================
 // FILE UTILITIES 
@@ -12,78 +15,140 @@
 namespace RLProfilePicturesFileUtils {
     
     bool EnsureTempDirectoryExists() {
-        if (std::filesystem::exists(RLProfilePicturesConstants::TEMP_DIRECTORY) && 
-            std::filesystem::is_directory(RLProfilePicturesConstants::TEMP_DIRECTORY)) {
+        // Once the directory has been seen (or created), skip the stat
+        // calls: this runs per avatar load and the answer never changes
+        // after the first success
+        static std::atomic<bool> s_dirEnsured{ false };
+        if (s_dirEnsured.load(std::memory_order_acquire)) {
             return true;
         }
-        
-        try {
-            std::filesystem::create_directory(RLProfilePicturesConstants::TEMP_DIRECTORY);
-            return true;
-        } 
-        catch (const std::filesystem::filesystem_error&) {
+
+        // Attempt the create directly instead of stat'ing first:
+        // create_directory succeeds or reports "already exists" in one
+        // call, and the error_code overload skips exception machinery
+        std::error_code ec;
+        std::filesystem::create_directory(RLProfilePicturesConstants::TEMP_DIRECTORY, ec);
+        if (ec && !std::filesystem::is_directory(RLProfilePicturesConstants::TEMP_DIRECTORY)) {
             return false;
         }
+
+        s_dirEnsured.store(true, std::memory_order_release);
+        return true;
     }
     
-    std::string WStringToUtf8(const std::wstring& w) {
+    std::string WStringToUtf8(std::wstring_view w) {
         if (w.empty()) return {};
-        int size_needed = WideCharToMultiByte(CP_UTF8, 0, w.c_str(), -1, nullptr, 0, nullptr, nullptr);
+
+        // Passing the explicit source length keeps the terminator out of
+        // the output, and the single call into a stack buffer covers every
+        // path-sized string without the size probe or a second transition
+        // into the converter
+        char stackBuf[1024];
+        int written = WideCharToMultiByte(CP_UTF8, 0, w.data(), static_cast<int>(w.size()),
+                                          stackBuf, static_cast<int>(sizeof(stackBuf)), nullptr, nullptr);
+        if (written > 0) {
+            return std::string(stackBuf, written);
+        }
+
+        // Input too long for the stack buffer: probe, then convert into the
+        // exactly-sized result
+        int size_needed = WideCharToMultiByte(CP_UTF8, 0, w.data(), static_cast<int>(w.size()),
+                                              nullptr, 0, nullptr, nullptr);
+        if (size_needed <= 0) return {};
         std::string strTo(size_needed, 0);
-        WideCharToMultiByte(CP_UTF8, 0, w.c_str(), -1, strTo.data(), size_needed, nullptr, nullptr);
+        WideCharToMultiByte(CP_UTF8, 0, w.data(), static_cast<int>(w.size()),
+                            strTo.data(), size_needed, nullptr, nullptr);
         return strTo;
     }
 
-    std::wstring Utf8ToWString(const std::string& str) {
-        if (str.empty()) 
+    std::wstring Utf8ToWString(std::string_view str) {
+        if (str.empty())
             return {};
-        int size_needed = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, nullptr, 0);
+
+        wchar_t stackBuf[512];
+        int written = MultiByteToWideChar(CP_UTF8, 0, str.data(), static_cast<int>(str.size()),
+                                          stackBuf, static_cast<int>(std::size(stackBuf)));
+        if (written > 0) {
+            return std::wstring(stackBuf, written);
+        }
+
+        int size_needed = MultiByteToWideChar(CP_UTF8, 0, str.data(), static_cast<int>(str.size()),
+                                              nullptr, 0);
+        if (size_needed <= 0) return {};
         std::wstring strTo(size_needed, 0);
-        MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, strTo.data(), size_needed);
+        MultiByteToWideChar(CP_UTF8, 0, str.data(), static_cast<int>(str.size()),
+                            strTo.data(), size_needed);
         return strTo;
     }
     
     bool OpenImageFileDialog(std::filesystem::path& outPath) {
-        wchar_t fileBuffer[MAX_PATH] = { 0 };
-        
-        OPENFILENAMEW ofn;
-        ZeroMemory(&ofn, sizeof(ofn));
-        ofn.lStructSize = sizeof(ofn);
-        ofn.hwndOwner = nullptr;
-        ofn.lpstrFilter =
-            L"Image Files (*.png;*.jpg;*.jpeg)\0*.png;*.jpg;*.jpeg\0"
-            L"PNG Files (*.png)\0*.png\0"
-            L"JPEG Files (*.jpg;*.jpeg)\0*.jpg;*.jpeg\0"
-            L"All Files (*.*)\0*.*\0\0";
-        ofn.lpstrFile = fileBuffer;
-        ofn.nMaxFile = MAX_PATH;
-        ofn.Flags = OFN_FILEMUSTEXIST | OFN_PATHMUSTEXIST | OFN_HIDEREADONLY;
-        ofn.lpstrDefExt = L"png";
-        
-        if (GetOpenFileNameW(&ofn) == TRUE) {
-            outPath = fileBuffer;
-            return true;
-        }
-        return false;
-    }
-    
-    std::string SanitizeFilename(const std::string& filename) {
-        std::string sanitized = filename;
-        std::string invalidChars = "<>:\"|?*\\/";
-        for (char& c : sanitized) {
-            if (invalidChars.find(c) != std::string::npos || c < 32) {
-                c = '_';
+        // Common Item Dialog instead of the legacy GetOpenFileNameW: the
+        // old dialog enumerates directories synchronously on the calling
+        // thread and crawls in large folders, while the shell dialog uses
+        // the namespace's cached, virtualized enumeration
+        static constexpr COMDLG_FILTERSPEC kImageFilters[] = {
+            { L"Image Files (*.png;*.jpg;*.jpeg)", L"*.png;*.jpg;*.jpeg" },
+            { L"PNG Files (*.png)",                L"*.png" },
+            { L"JPEG Files (*.jpg;*.jpeg)",        L"*.jpg;*.jpeg" },
+            { L"All Files (*.*)",                  L"*.*" },
+        };
+
+        const HRESULT initHr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
+        const bool needUninit = SUCCEEDED(initHr);
+
+        bool selected = false;
+        IFileOpenDialog* dialog = nullptr;
+        if (SUCCEEDED(CoCreateInstance(CLSID_FileOpenDialog, nullptr, CLSCTX_INPROC_SERVER,
+                                       IID_PPV_ARGS(&dialog)))) {
+            dialog->SetFileTypes(static_cast<UINT>(std::size(kImageFilters)), kImageFilters);
+            dialog->SetDefaultExtension(L"png");
+
+            // Skip side work the picker has no use for: no working-directory
+            // change, no recent-documents indexing entry, and only real
+            // filesystem items (which also guarantees SIGDN_FILESYSPATH
+            // resolves for the result)
+            DWORD options = 0;
+            if (SUCCEEDED(dialog->GetOptions(&options))) {
+                dialog->SetOptions(options | FOS_NOCHANGEDIR | FOS_DONTADDTORECENT | FOS_FORCEFILESYSTEM);
+            }
+
+            if (SUCCEEDED(dialog->Show(nullptr))) {
+                IShellItem* item = nullptr;
+                if (SUCCEEDED(dialog->GetResult(&item))) {
+                    PWSTR pathStr = nullptr;
+                    if (SUCCEEDED(item->GetDisplayName(SIGDN_FILESYSPATH, &pathStr))) {
+                        outPath = pathStr;
+                        CoTaskMemFree(pathStr);
+                        selected = true;
+                    }
+                    item->Release();
+                }
             }
+            dialog->Release();
         }
-        return sanitized;
-    }
-    
-    std::filesystem::path GetTempAvatarPath(const std::string& idString) {
-        return GetTempDirectory() / RLProfilePicturesConstants::TEMP_AVATAR_PREFIX / (idString + ".png");
+
+        if (needUninit) {
+            CoUninitialize();
+        }
+        return selected;
     }
     
-    std::filesystem::path GetTempLocalAvatarPath(const std::string& idString) {
-        return GetTempDirectory() / RLProfilePicturesConstants::TEMP_LOCAL_PREFIX / (idString + ".png");
+    std::wstring GetTempAvatarPathW(const std::string& idString) {
+        // Same layout GetTempDirectory() / TEMP_AVATAR_PREFIX / id + ".png"
+        // used to produce, with the constant part computed once. IDs have
+        // been through SanitizeFilename, so the widening below is a plain
+        // per-character copy
+        static const std::wstring prefix =
+            (GetTempDirectory() / RLProfilePicturesConstants::TEMP_AVATAR_PREFIX).wstring() + L'\\';
+
+        std::wstring path;
+        path.reserve(prefix.size() + idString.size() + 4);
+        path = prefix;
+        for (char c : idString) {
+            path += static_cast<wchar_t>(static_cast<unsigned char>(c));
+        }
+        path += L".png";
+        return path;
     }
     
     std::filesystem::path GetBrightenedLocalAvatarPath() {
@@ -92,4 +157,46 @@ namespace RLProfilePicturesFileUtils {
     std::filesystem::path GetTempDirectory() {
         return std::filesystem::path(RLProfilePicturesConstants::TEMP_DIRECTORY);
     }
+
+    namespace {
+        // Pending deletions and whether a worker is currently draining them.
+        // The worker exits as soon as the queue runs dry (and is respawned by
+        // the next RemoveAsync), so no thread lingers past plugin unload
+        std::mutex s_deleteMutex;
+        std::vector<std::filesystem::path> s_deleteQueue;
+        bool s_deleteWorkerRunning = false;
+
+        void DrainDeleteQueue() {
+            for (;;) {
+                std::vector<std::filesystem::path> batch;
+                {
+                    std::lock_guard<std::mutex> lock(s_deleteMutex);
+                    if (s_deleteQueue.empty()) {
+                        s_deleteWorkerRunning = false;
+                        return;
+                    }
+                    batch.swap(s_deleteQueue);
+                }
+                for (const auto& path : batch) {
+                    std::error_code ec;
+                    std::filesystem::remove(path, ec);
+                }
+            }
+        }
+    }
+
+    void RemoveAsync(std::filesystem::path filePath) {
+        bool spawnWorker = false;
+        {
+            std::lock_guard<std::mutex> lock(s_deleteMutex);
+            s_deleteQueue.push_back(std::move(filePath));
+            if (!s_deleteWorkerRunning) {
+                s_deleteWorkerRunning = true;
+                spawnWorker = true;
+            }
+        }
+        if (spawnWorker) {
+            std::thread(DrainDeleteQueue).detach();
+        }
+    }
 }
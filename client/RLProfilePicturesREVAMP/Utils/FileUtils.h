@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <filesystem>
 
@@ -23,40 +24,35 @@ namespace RLProfilePicturesFileUtils {
      */
     bool OpenImageFileDialog(std::filesystem::path& outPath);
     
-    /**
-     * Sanitizes a filename by replacing invalid characters with underscores
-     * @param filename The filename to sanitize
-     * @return The sanitized filename
-     */
-    std::string SanitizeFilename(const std::string& filename);
-    
     /**
      * Converts a wide string to UTF-8
+     * Converts in a single Win32 call through a stack buffer for
+     * path-sized input; the probe-then-allocate round trip only happens
+     * for strings too long for the buffer. The result carries no
+     * embedded terminator — .size() is the exact character count
      * @param w The wide string to convert
      * @return The UTF-8 string
      */
-    std::string WStringToUtf8(const std::wstring& w);
+    std::string WStringToUtf8(std::wstring_view w);
 
     /**
      * Converts a UTF-8 string to wstring
+     * Single-call stack-buffer fast path, same as WStringToUtf8
      * @param str The UTF-8 string to convert
      * @return The wstring
      */
-    std::wstring Utf8ToWString(const std::string& str);
+    std::wstring Utf8ToWString(std::string_view str);
     
     /**
-     * Generates a temporary file path for avatar storage
-     * @param idString The ID string to use in the filename
-     * @return The full temporary file path
+     * Generates a temporary file path for avatar storage as a native wide
+     * string. The constant directory prefix is built once and each call
+     * only appends the ID and extension, so the per-download cost is a
+     * single string allocation instead of the chain of path constructions
+     * operator/ performs
+     * @param idString The sanitized ID string to use in the filename
+     * @return The full temporary file path, native (wide) encoding
      */
-    std::filesystem::path GetTempAvatarPath(const std::string& idString);
-    
-    /**
-     * Generates a temporary file path for local avatar storage
-     * @param idString The ID string to use in the filename
-     * @return The full temporary file path
-     */
-    std::filesystem::path GetTempLocalAvatarPath(const std::string& idString);
+    std::wstring GetTempAvatarPathW(const std::string& idString);
     
     /**
      * Gets the standard brightened local avatar path
@@ -69,4 +65,11 @@ namespace RLProfilePicturesFileUtils {
      * @return The full path to temporary directory
      */
     std::filesystem::path GetTempDirectory();
+
+    /**
+     * Deletes a file on a short-lived background worker so callers on the
+     * game thread never pay the unlink syscall; failures are ignored
+     * @param filePath The file to delete
+     */
+    void RemoveAsync(std::filesystem::path filePath);
 }
@@ -1,53 +1,88 @@
 #include "pch.h"
 #include "Logger.h"
 #include "../Config/Constants.h"
+#include <string_view>
 
 // =============================================================================
 // LOGGER
 // =============================================================================
 
 namespace RLProfilePicturesLogger {
-    
+
     // Static variables for logger state
     static std::shared_ptr<CVarManagerWrapper> s_cvarManager = nullptr;
     static std::shared_ptr<bool> s_debugLogsEnabled = nullptr;
-    
+
+    // Color escape prefixes as compile-time views, assembled into one
+    // exactly-sized string per line — the operator+ chain this replaces
+    // made two heap allocations per log call
+    static constexpr std::string_view INFO_PREFIX    = "\x1b[38;2;102;204;255m[INFO] ";
+    static constexpr std::string_view SUCCESS_PREFIX = "\x1b[38;2;102;255;102m[SUCCESS] ";
+    static constexpr std::string_view ERROR_PREFIX   = "\x1b[38;2;255;102;102m[ERROR] ";
+    static constexpr std::string_view DEBUG_PREFIX   = "\x1b[38;2;255;255;102m[DEBUG] ";
+    static constexpr std::string_view COLOR_RESET    = "\x1b[39m";
+
+    static void LogColored(std::string_view prefix, std::string_view message) {
+        std::string line;
+        line.reserve(prefix.size() + message.size() + COLOR_RESET.size());
+        line.append(prefix);
+        line.append(message);
+        line.append(COLOR_RESET);
+        s_cvarManager->log(std::move(line));
+    }
+
     void Initialize(std::shared_ptr<CVarManagerWrapper> cvarManager, std::shared_ptr<bool> debugLogsEnabled) {
         s_cvarManager = cvarManager;
         s_debugLogsEnabled = debugLogsEnabled;
     }
-    
-    void LogInfo(const std::string& message) {
+
+    void LogInfo(std::string_view message) {
         if (s_cvarManager) {
-            s_cvarManager->log("\x1b[38;2;102;204;255m[INFO] " + message + "\x1b[39m");
+            LogColored(INFO_PREFIX, message);
         }
     }
-    
-    void LogSuccess(const std::string& message) {
+
+    void LogSuccess(std::string_view message) {
         if (s_cvarManager) {
-            s_cvarManager->log("\x1b[38;2;102;255;102m[SUCCESS] " + message + "\x1b[39m");
+            LogColored(SUCCESS_PREFIX, message);
         }
     }
-    
-    void LogError(const std::string& message) {
+
+    void LogError(std::string_view message) {
         if (s_cvarManager) {
-            s_cvarManager->log("\x1b[38;2;255;102;102m[ERROR] " + message + "\x1b[39m");
+            LogColored(ERROR_PREFIX, message);
         }
     }
-    
-    void LogDebug(const std::string& message) {
+
+    void LogDebug(std::string_view message) {
         if (!s_cvarManager) return;
-        
-        // Check if debug logs are enabled via the shared bool pointer
-        if (s_debugLogsEnabled && *s_debugLogsEnabled) {
-            s_cvarManager->log("\x1b[38;2;255;255;102m[DEBUG] " + message + "\x1b[39m");
+
+        // The bound flag is authoritative once wired: one load decides.
+        // Previously a false flag still fell through to getCvar, paying a
+        // name lookup per call with debug logging switched off
+        if (s_debugLogsEnabled) {
+            if (*s_debugLogsEnabled) {
+                LogColored(DEBUG_PREFIX, message);
+            }
             return;
         }
-        
-        // Fallback: check the CVar directly
+
+        // Fallback for the never-initialized case: check the CVar directly
         CVarWrapper debugCVar = s_cvarManager->getCvar(RLProfilePicturesConstants::CVAR_DEBUG_LOGS);
         if (!debugCVar.IsNull() && debugCVar.getBoolValue()) {
-            s_cvarManager->log("\x1b[38;2;255;255;102m[DEBUG] " + message + "\x1b[39m");
+            LogColored(DEBUG_PREFIX, message);
         }
     }
+
+    bool IsDebugEnabled() {
+        if (!s_cvarManager) return false;
+
+        if (s_debugLogsEnabled) {
+            return *s_debugLogsEnabled;
+        }
+
+        // Fallback: check the CVar directly
+        CVarWrapper debugCVar = s_cvarManager->getCvar(RLProfilePicturesConstants::CVAR_DEBUG_LOGS);
+        return !debugCVar.IsNull() && debugCVar.getBoolValue();
+    }
 }
@@ -2,6 +2,7 @@
 
 #include "bakkesmod/plugin/bakkesmodplugin.h"
 #include <string>
+#include <string_view>
 #include <memory>
 
 // =============================================================================
@@ -19,21 +20,44 @@ namespace RLProfilePicturesLogger {
     /**
      * Log an informational message (blue color)
      */
-    void LogInfo(const std::string& message);
+    void LogInfo(std::string_view message);
     
     /**
      * Log a success message (green color)
      */
-    void LogSuccess(const std::string& message);
+    void LogSuccess(std::string_view message);
     
     /**
      * Log an error message (red color)
      */
-    void LogError(const std::string& message);
+    void LogError(std::string_view message);
     
     /**
      * Log a debug message (yellow color)
      * Only displays if debug logging is enabled
      */
-    void LogDebug(const std::string& message);
+    void LogDebug(std::string_view message);
+
+    /**
+     * Check whether debug logging is currently enabled
+     * Lets hot paths skip building debug-only message strings
+     */
+    bool IsDebugEnabled();
 }
+
+/**
+ * Debug log macro: the message expression is only evaluated when debug
+ * logging is enabled, so the string concatenations at call sites cost
+ * nothing while the CVar is off. Define RLPP_NO_DEBUG_LOGS to compile
+ * the calls out of the binary entirely
+ */
+#ifdef RLPP_NO_DEBUG_LOGS
+#define RLPP_LOG_DEBUG(message) do { } while (0)
+#else
+#define RLPP_LOG_DEBUG(message)                              \
+    do {                                                     \
+        if (RLProfilePicturesLogger::IsDebugEnabled()) {     \
+            RLProfilePicturesLogger::LogDebug(message);      \
+        }                                                    \
+    } while (0)
+#endif
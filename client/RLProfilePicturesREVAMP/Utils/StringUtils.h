@@ -1,17 +1,51 @@
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
 
 // =============================================================================
 // STRING UTILITIES
 // =============================================================================
 
 namespace RLProfilePicturesStringUtils {
-    
+
+    namespace detail {
+        // One entry per byte value, built at compile time: the characters
+        // Windows forbids in filenames, the control range, and everything
+        // past ASCII (the old signed `c < 32` test caught those too, and
+        // downstream path code assumes sanitized IDs are plain ASCII).
+        // The per-character test becomes a single table load instead of a
+        // scan over the invalid-character string
+        inline constexpr auto kInvalidFilenameChar = [] {
+            std::array<bool, 256> t{};
+            for (char c : std::string_view("<>:\"|?*\\/")) {
+                t[static_cast<unsigned char>(c)] = true;
+            }
+            for (int i = 0; i < 32; ++i) {
+                t[i] = true;
+            }
+            for (int i = 128; i < 256; ++i) {
+                t[i] = true;
+            }
+            return t;
+        }();
+    }
+
     /**
      * Sanitizes a filename by replacing invalid characters with underscores
+     * Defined inline in the header so per-ID sanitization inlines at the
+     * call site, and takes a view so callers never build an intermediate
      * @param filename The filename to sanitize
      * @return The sanitized filename
      */
-    std::string SanitizeFilename(const std::string& filename);
+    inline std::string SanitizeFilename(std::string_view filename) {
+        std::string sanitized(filename);
+        for (char& c : sanitized) {
+            if (detail::kInvalidFilenameChar[static_cast<unsigned char>(c)]) {
+                c = '_';
+            }
+        }
+        return sanitized;
+    }
 }
@@ -63,6 +63,9 @@ inline T* Cast(UObject* obj) {
 #include "Memory/MemoryHelper.h"
 #include "RocketLeague/RLObjects.h"
 #include "Avatar/ImageProcessor.h"
+#include "Avatar/AvatarCache.h"
+#include "Avatar/ByteBufferPool.h"
+#include "Avatar/AvatarHttpClient.h"
 #include "Avatar/AvatarDownloader.h"
 #include "Avatar/AvatarManager.h"
 #include "UI/SettingsUI.h"
\ No newline at end of file
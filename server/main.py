@@ -3,6 +3,7 @@ import asyncio
 from contextlib import asynccontextmanager
 from fastapi import FastAPI, Request
 from fastapi.middleware.cors import CORSMiddleware
+from fastapi.middleware.gzip import GZipMiddleware
 from fastapi.responses import JSONResponse
 from slowapi import Limiter, _rate_limit_exceeded_handler
 from slowapi.util import get_remote_address
@@ -108,6 +109,11 @@ app.add_exception_handler(RateLimitExceeded, rate_limit_handler)
 # Add tracking middleware
 app.add_middleware(TrackingMiddleware, database=database)
 
+# Compress responses for clients that advertise gzip support. JSON bodies
+# (bulk avatar results are base64-heavy) shrink several-fold; small bodies
+# and already-compressed image bytes are left alone by the minimum size.
+app.add_middleware(GZipMiddleware, minimum_size=1024)
+
 # Include routers
 app.include_router(epic.router)
 app.include_router(platforms.router)
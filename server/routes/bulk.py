@@ -6,6 +6,7 @@ from pydantic import BaseModel, Field
 from cache.cache_manager import CacheManager
 from database.models import Database
 from services.avatar_services import SteamAvatarService, XboxAvatarService, PSNAvatarService, SwitchAvatarService
+from services.default_service import default_service
 from middleware.rate_limiter import rate_limit_middleware
 from slowapi.util import get_remote_address
 import asyncio
@@ -20,6 +21,7 @@ class BulkAvatarRequest(BaseModel):
     """Request model for bulk avatar retrieval."""
     user_ids: List[str] = Field(..., min_items=1, max_items=100, description="List of user IDs (max 100)")
     platform: str = Field(..., description="Platform name (steam, xbox, psn, switch, epic)")
+    default_enabled: bool = Field(False, description="Use default avatar if user avatar not found")
 
 
 class AvatarResult(BaseModel):
@@ -91,68 +93,76 @@ async def get_avatar_service(platform: str):
     return services[platform]
 
 
-async def process_single_avatar(platform: str, user_id: str, cache: CacheManager, db: Database) -> AvatarResult:
+async def not_found_result(platform: str, user_id: str, error: str, default_enabled: bool) -> AvatarResult:
+    """Build the result for a user whose avatar could not be retrieved.
+
+    When default_enabled is set, falls back to the platform's default
+    avatar (mirroring the single retrieve routes) so the client does not
+    negative-cache the user.
+    """
+    if default_enabled:
+        default_image = await default_service.get_default_avatar(platform)
+        if default_image is not None:
+            logger.info(f"Avatar not found for {platform} user {user_id}, using default avatar")
+            import base64
+            return AvatarResult(
+                user_id=user_id,
+                found=True,
+                cached=False,
+                avatar_data=base64.b64encode(default_image).decode('utf-8'),
+                error="Default avatar used"
+            )
+    return AvatarResult(
+        user_id=user_id,
+        found=False,
+        cached=False,
+        error=error
+    )
+
+
+async def process_single_avatar(platform: str, user_id: str, cache: CacheManager, db: Database,
+                                default_enabled: bool = False) -> AvatarResult:
     """Process a single avatar request."""
     try:
         # Check cache first
         image_data = await cache.get(platform, user_id)
         cache_hit = image_data is not None
-        
+
         if image_data is None and platform != "epic":
             # Fetch from platform API (Epic doesn't have API, only cache)
             logger.info(f"Fetching {platform} avatar for {user_id}")
             service = await get_avatar_service(platform)
-            
+
             if service:
                 try:
                     image_data = await asyncio.wait_for(service.get_processed_avatar(user_id), timeout=20.0)
                 except asyncio.TimeoutError:
                     logger.warning(f"{platform} avatar fetch timed out for {user_id}")
-                    return AvatarResult(
-                        user_id=user_id,
-                        found=False,
-                        cached=False,
-                        error="Fetch timed out"
-                    )
+                    return await not_found_result(platform, user_id, "Fetch timed out", default_enabled)
                 except Exception as e:
                     logger.error(f"Error fetching {platform} avatar for {user_id}: {e}")
-                    return AvatarResult(
-                        user_id=user_id,
-                        found=False,
-                        cached=False,
-                        error=str(e)
-                    )
-                
+                    return await not_found_result(platform, user_id, str(e), default_enabled)
+
                 if image_data:
                     # Save to cache
                     await cache.set(platform, user_id, image_data)
-                    await db.update_cache_metadata(platform, user_id, 
-                                                  str(cache.get_file_path(platform, user_id)), 
+                    await db.update_cache_metadata(platform, user_id,
+                                                  str(cache.get_file_path(platform, user_id)),
                                                   len(image_data))
                 else:
-                    return AvatarResult(
-                        user_id=user_id,
-                        found=False,
-                        cached=False,
-                        error="Avatar not found"
-                    )
+                    return await not_found_result(platform, user_id, "Avatar not found", default_enabled)
             else:
-                return AvatarResult(
-                    user_id=user_id,
-                    found=False,
-                    cached=False,
-                    error="Platform service unavailable"
-                )
-        
+                return await not_found_result(platform, user_id, "Platform service unavailable", default_enabled)
+
         if image_data:
             # Convert to base64 for JSON response
             import base64
             avatar_b64 = base64.b64encode(image_data).decode('utf-8')
-            
+
             # Update cache access if it was a cache hit
             if cache_hit:
                 await db.update_cache_access(platform, user_id)
-            
+
             return AvatarResult(
                 user_id=user_id,
                 found=True,
@@ -160,13 +170,8 @@ async def process_single_avatar(platform: str, user_id: str, cache: CacheManager
                 avatar_data=avatar_b64
             )
         else:
-            return AvatarResult(
-                user_id=user_id,
-                found=False,
-                cached=False,
-                error="Avatar not found"
-            )
-            
+            return await not_found_result(platform, user_id, "Avatar not found", default_enabled)
+
     except Exception as e:
         logger.error(f"Error processing {platform} avatar for {user_id}: {e}")
         return AvatarResult(
@@ -217,7 +222,8 @@ async def get_bulk_avatars(
         
         async def process_with_semaphore(user_id: str):
             async with semaphore:
-                return await process_single_avatar(platform, user_id, cache, db)
+                return await process_single_avatar(platform, user_id, cache, db,
+                                                   request_data.default_enabled)
         
         # Process all avatars concurrently
         results = await asyncio.gather(*[process_with_semaphore(user_id) for user_id in user_ids])
@@ -274,26 +280,28 @@ async def get_bulk_avatars_get(
     platform: str,
     user_ids: str,  # Comma-separated list
     request: Request,
+    default_enabled: bool = False,
     cache: CacheManager = Depends(get_cache_manager),
     db: Database = Depends(get_database)
 ):
     """
     GET version of bulk avatar retrieval.
-    
-    Usage: /api/v1/bulk/avatars/steam?user_ids=123,456,789
+
+    Usage: /api/v1/bulk/avatars/steam?user_ids=123,456,789&default_enabled=true
     """
     try:
         # Parse user IDs
         user_id_list = [uid.strip() for uid in user_ids.split(",") if uid.strip()]
-        
+
         if not user_id_list:
             raise HTTPException(status_code=400, detail="No user IDs provided")
-        
+
         if len(user_id_list) > 100:
             raise HTTPException(status_code=400, detail="Maximum 100 user IDs allowed")
-        
+
         # Create request data and use POST endpoint logic
-        request_data = BulkAvatarRequest(user_ids=user_id_list, platform=platform)
+        request_data = BulkAvatarRequest(user_ids=user_id_list, platform=platform,
+                                         default_enabled=default_enabled)
         return await get_bulk_avatars(request_data, request, cache, db)
         
     except HTTPException: